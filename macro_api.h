@@ -51,6 +51,46 @@
 #define F_REDUCE_DBG(_,ARGS) _F_REDUCE_DBG ARGS
 #define _F_REDUCE_DBG(IDX,ARGS,FUNC,AKK) (COUNT_N(IDX): FUNC,(_TAKE0 ARGS,_REDUCEI AKK) = FUNC(_TAKE0 ARGS,_REDUCEI AKK)),
 
+/** Reduces the non-blank arguments pairwise to a balanced tree FUNC(FUNC(a,b),FUNC(c,d)) instead of the
+ * chain of REDUCE, for associative FUNCs only. The parse depth is logarithmic and the CPU can execute
+ * the independent pairs in parallel. FUNC(A,B) can be a macro or a function name.
+ * Each WHILE cycle combines one tree level of up to LOOPMAX elements. */
+#define TREE_REDUCE(FUNC,...) _TREE_REDUCE(_TREECALL,FUNC,__VA_ARGS__)
+//the same with a binary operator: TREE_REDUCE_OP(+,a,b,c,d,e) is (((a + b) + (c + d)) + e), TREE_REDUCE_OP(+,a,,b) is (a + b)
+#define TREE_REDUCE_OP(OP,...) _TREE_REDUCE(_TREEOP,OP,__VA_ARGS__)
+//the loop stops at a blank second element, which the take drops
+#define _TREE_REDUCE(COMB,FUNC,...) _TREETAKE(_TREEDROP(_TREEDROP(WHILE(P_TREE,F_TREE,COMB,FUNC,__VA_ARGS__))))
+#define _TREEDROP(...) _DROP0(__VA_ARGS__)
+#define _TREETAKE(...) _TAKE0(__VA_ARGS__,)
+#define _TREECALL(FUNC,A,B) FUNC(A,B)
+#define _TREEOP(OP,A,B) (A OP B)
+//continues while there is a second element
+#define P_TREE(COMB,FUNC,A,...) BOOL(__VA_ARGS__)
+#define F_TREE(COMB,FUNC,...) COMB,FUNC _REPEATN(ARGNUM(__VA_ARGS__),F_TREEPAIR,_TREESTEP,(COMB,FUNC,__VA_ARGS__),)
+#define F_TREEPAIR(_,ARGS) _TREEPAIR ARGS
+//a blank element of the pair is dropped, the other one moves up a level
+#define _TREEPAIR(COMB,FUNC,A,...) _TREEPAIR0(COMB,FUNC,A,_TAKE0(__VA_ARGS__,))
+#define _TREEPAIR0(COMB,FUNC,A,B) IF_ELSE(A,_TREEPAIRA,_TREEPAIRB)(COMB,FUNC,A,B)
+#define _TREEPAIRA(COMB,FUNC,A,B) IF_ELSE(B,_TREECOMB,_TREEKEEP)(COMB,FUNC,A,B)
+#define _TREEPAIRB(COMB,FUNC,A,B) IF(B,I(, B))
+#define _TREECOMB(COMB,FUNC,A,B) , COMB(FUNC,A,B)
+#define _TREEKEEP(COMB,FUNC,A,B) , A
+#define _TREESTEP(ARGS) _TREESTEP0 ARGS
+#define _TREESTEP0(COMB,FUNC,...) (COMB,FUNC,_TREEDROP(_TREEDROP(__VA_ARGS__)))
+
+//lite mode for IDEs, see LITE_SIZE. Any value of MACRO_LITE but 0 switches it on, a blank one leaves 1 - - 1 == 2
+#ifndef MACRO_LITE
+#if defined(__CDT_PARSER__) || defined(__INTELLISENSE__) || defined(__JETBRAINS_IDE__)
+#define _LITE 1
+#else
+#define _LITE 0
+#endif
+#elif 1 - MACRO_LITE - 1 == 2 || MACRO_LITE + 0
+#define _LITE 1
+#else
+#define _LITE 0
+#endif
+
 /** IMPORTANT! This unary number defines the maximum number of used loop cycles per loop call.
  *
  * I don't know why but every increase of the limit significantly increases Ubuntu startup time of
@@ -65,6 +105,35 @@
  */
 #define LOOPLIMIT ADD(PP10,PP6)
 //#define LOOPLIMIT LOOPMAX
+#if _LITE
+#undef LOOPLIMIT
+#define LOOPLIMIT PP12
+#endif
+/** Opt-in budget mode. #define MACRO_BUDGET before including this file to let runaway computations fail
+ * fast with a preprocessor error naming the macro, instead of silently expanding to blank after the last
+ * cycle or cutting off elements. This concerns WHILE, ITERATE, DIV, CARTESIAN, CARTPOW, FLATTEN and everything
+ * built on them. The value of MACRO_BUDGET is ignored, so -DMACRO_BUDGET (1) and -DMACRO_BUDGET= both work.
+ * MACRO_BUDGET_CYCLES lowers the WHILE cycles to a unary number below LOOPLIMIT, e.g. PP8. */
+#ifdef MACRO_BUDGET_CYCLES
+#define _BUDGETLIMIT MACRO_BUDGET_CYCLES
+#else
+#define _BUDGETLIMIT LOOPLIMIT
+#endif
+#ifdef MACRO_BUDGET
+//fails, if the WHILE result A is blank
+#define _BUDGETCHECK(NAME,A) APPLYIFNOT(A,_BUDGETFAIL,(NAME))
+//fails, if the list has more elements than the unary LIMIT
+#define _BUDGETCUT(NAME,LIMIT,...) APPLYIF(DROP_N(LIMIT,__VA_ARGS__),_BUDGETFAIL,(NAME))
+//fails, if an element of the list still starts with a group
+#define _BUDGETGROUPS(NAME,...) APPLYIF(_FLATTENANY(__VA_ARGS__),_BUDGETFAIL,(NAME))
+/* An invalid concatenation is an immediate preprocessor error, even in macro arguments where #pragma GCC error
+ * is deferred or dropped. The error message shows the pasted MACRO_BUDGET_EXCEEDED_BY_<NAME> symbol. */
+#define _BUDGETFAIL(NAME) MACRO_BUDGET_EXCEEDED_BY_ ## NAME ## .
+#else
+#define _BUDGETCHECK(NAME,A)
+#define _BUDGETCUT(NAME,LIMIT,...)
+#define _BUDGETGROUPS(NAME,...)
+#endif
 //maximum number of loop cycles as unary number
 #define LOOPMAX (_LOOPMAXDROP(_ARGNUMLIST))
 //maximum number of loop cycles as integer literal
@@ -286,6 +355,27 @@
 #define F_ZIP2(A,ARGS) _ZIP2(A,_TAKE0 ARGS,_DROP0 ARGS)
 #define _ZIP2(A,F,LIST) APPLYIF(OR(A,_TAKE0 LIST),F,(_TAKE0 LIST,A))
 
+/** N-ary ZIP. Calls FUNC with the i-th elements of all parenthesized lists for each index i of the first list
+ * and separates the expansions with commas. Missing elements of shorter lists are blank. If FUNC is blank,
+ * every tuple of i-th elements is expanded in parentheses. It's a single pass over the lists, each cycle
+ * takes the heads of all lists and drops them. FUNC must not call _REPEAT based macros.
+ * e.g. ZIP_N(,(1,2,3),(a,b,c)) expands to (1,a),(2,b),(3,c) */
+#define ZIP_N(FUNC,LIST,...) _ZIP_NDROP(_REPEATN(ARGNUM(_ZIPI LIST),F_ZIP_N,_ZIP_NSTEP,(TRY(FUNC,_ZIP_NTUPLE),LIST,##__VA_ARGS__),))
+/** inverse of ZIP_N with blank FUNC. It turns a list of parenthesized tuples into a list of parenthesized
+ * lists, each with the elements of one tuple position, e.g. for de-interleaving an array of structures. */
+#define UNZIP(...) ZIP_N(,__VA_ARGS__)
+/** transposes a matrix given as parenthesized rows of equal length into the parenthesized columns. */
+#define TRANSPOSE(...) ZIP_N(,__VA_ARGS__)
+#define _ZIP_NDROP(...) _DROP0(__VA_ARGS__)
+#define _ZIP_NTUPLE(...) (__VA_ARGS__)
+#define F_ZIP_N(_,ARGS) _ZIP_N0 ARGS
+#define _ZIP_N0(FUNC,...) , _ZIP_N1(FUNC,_ZIP_NDROP(_MAPN(ARGNUM(__VA_ARGS__),F_ZIP_NHEAD,_MAPI0,,__VA_ARGS__)))
+#define _ZIP_N1(FUNC,...) FUNC(__VA_ARGS__)
+#define F_ZIP_NHEAD(A,_) , _TAKE0 A
+#define _ZIP_NSTEP(ARGS) _ZIP_NSTEP0 ARGS
+#define _ZIP_NSTEP0(FUNC,...) (FUNC _MAPN(ARGNUM(__VA_ARGS__),F_ZIP_NTAIL,_MAPI0,,__VA_ARGS__))
+#define F_ZIP_NTAIL(A,_) , (_DROP0 A)
+
 //this is a "ZIP bomb" XD!! It can crash your PC with Atollic because _TAKE0 AND _DROP0 are undefined here!
 //int x = ZIP(CONC,(1,2),1,2);	//DON'T UNCOMMENT!!
 
@@ -348,10 +438,12 @@
 
 /** Implements a while Loop in the preprocessor. In each cycle it executes FUNC with the result
  * of the previous cycle. It will stop when PREDICATE applied to the result is blank. */
-#define WHILE(PREDICATE,FUNC,...) _WHILE((PREDICATE,FUNC,(__VA_ARGS__)),UNGROUP(LOOPLIMIT))
-#define _WHILE(ARGS,...) _WHILETAKE(_MAP(F_WHILE,_WHILECYCLE,ARGS,__VA_ARGS__))
-#define _WHILETAKE(...) _WHILETAKE0(__VA_ARGS__)
-#define _WHILETAKE0(A,...) APPLYIF(A,_WHILEI,A)
+#define WHILE(PREDICATE,FUNC,...) _WHILEAS(WHILE,PREDICATE,FUNC,__VA_ARGS__)
+//NAME is the macro which is reported when exceeding the MACRO_BUDGET
+#define _WHILEAS(NAME,PREDICATE,FUNC,...) _WHILE(NAME,(PREDICATE,FUNC,(__VA_ARGS__)),UNGROUP(_BUDGETLIMIT))
+#define _WHILE(NAME,ARGS,...) _WHILETAKE(NAME,_MAP(F_WHILE,_WHILECYCLE,ARGS,__VA_ARGS__))
+#define _WHILETAKE(NAME,...) _WHILETAKE0(NAME,__VA_ARGS__)
+#define _WHILETAKE0(NAME,A,...) APPLYIF(A,_WHILEI,A)_BUDGETCHECK(NAME,A)
 #define _WHILEI(...) __VA_ARGS__
 #define F_WHILE(_,ARGS) _WHILE0 ARGS
 #define _WHILE0(PREDICATE,FUNC,ARGS) IFNOT(PREDICATE ARGS,I(ARGS,))
@@ -382,7 +474,7 @@
  *  of elements. It will stop automatically if the first list element
  *  is blank. If it will not reach the end within the LIMIT of _MAPx
  *  cycles, it will expand to blank (which could mean that you have an endless loop). */
-#define ITERATE(FUNC,...) _ITERATE(WHILE(P_NOBLANK,FUNC,__VA_ARGS__,,END_))
+#define ITERATE(FUNC,...) _ITERATE(_WHILEAS(ITERATE,P_NOBLANK,FUNC,__VA_ARGS__,,END_))
 #define _ITERATE(...) APPLYIF(I(__VA_ARGS__),_ITERATE0,(__VA_ARGS__))
 #define _ITERATE0(A,B,...) __VA_ARGS__
 //debugging
@@ -409,14 +501,30 @@
 #define P_DROPTAIL(A,...) STARTSWITH(_WHILE,A)
 #define F_DROPTAIL(A,...) __VA_ARGS__
 
-/* tries to remove all nested parentheses from the argument list. It can only reach parentheses which
- * start the element. */
-#define FLATTEN(...) ITERATE(F_FLATTEN,__VA_ARGS__)
-//if starting with pair of paren: remove, else: go to next element
-#define F_FLATTEN(...) _FLATTEN(STARTSGROUP(__VA_ARGS__),__VA_ARGS__)
-#define _FLATTEN(COND,...) APPLYIF(COND,_FLATTEN0,(_FLATTENI __VA_ARGS__))APPLYIFNOT(COND,ITER_NEXT,(__VA_ARGS__))
+/* removes nested parentheses from the argument list level by level. Each WHILE cycle unwraps the groups
+ * which start an element, for all elements at once, so the cost is the nesting depth times the element
+ * count. Parentheses after the first token of an element stay, e.g. FLATTEN(x (y),(0)) is x (y),0, because
+ * the preprocessor can't split off an arbitrary token. Empty groups vanish. At most LOOPLIMIT - 1 levels
+ * are removed, deeper groups stay in place or fail with MACRO_BUDGET. */
+#define FLATTEN(...) _FLATTENCHECK(_FLATTEN(SUB_ONE(LOOPLIMIT),__VA_ARGS__))
+#define _FLATTENCHECK(...) __VA_ARGS__ _BUDGETGROUPS(FLATTEN,__VA_ARGS__)
+//removes at most N (decimal literal) nesting levels
+#define FLATTEN_DEPTH(N,...) _FLATTEN(TO_UNARY(N),__VA_ARGS__)
+#define _FLATTEN(DEPTH,...) _FLATTENDROP(WHILE(P_FLATTEN,F_FLATTEN,1,DEPTH,__VA_ARGS__))
+#define _FLATTENDROP(...) _FLATTENDROP0(__VA_ARGS__)
+#define _FLATTENDROP0(FLAG,DEPTH,...) __VA_ARGS__
 #define _FLATTENI(...) __VA_ARGS__
-#define _FLATTEN0(A,...) OPT(A)__VA_ARGS__
+//continues while the last level contained a group and the DEPTH is not exhausted
+#define P_FLATTEN(FLAG,DEPTH,...) AND(FLAG,_FLATTENI DEPTH)
+#define F_FLATTEN(FLAG,DEPTH,...) _FLATTEN0(SUB_ONE(DEPTH),_FLATTENLEVEL(__VA_ARGS__))
+#define _FLATTEN0(DEPTH,...) _FLATTENANY(__VA_ARGS__),DEPTH,__VA_ARGS__
+#define _FLATTENANY(...) _REPEATN(ARGNUM(__VA_ARGS__),F_FLATTENANY,_REPEATI0,,__VA_ARGS__)
+#define F_FLATTENANY(A,_) STARTSGROUP(A)
+#define _FLATTENLEVEL(...) _FLATTENLEVELDROP(_REPEATN(ARGNUM(__VA_ARGS__),F_FLATTENLEVEL,_REPEATI0,,__VA_ARGS__))
+#define _FLATTENLEVELDROP(...) _DROP0(__VA_ARGS__)
+//if starting with pair of paren: remove, else: keep the element
+#define F_FLATTENLEVEL(A,_) _FLATTENLEVEL0(STARTSGROUP(A),A)
+#define _FLATTENLEVEL0(COND,A) APPLYIF(COND,_VARGS,(_FLATTENI A))IFNOT(COND,_FLATTENI(, A))
 /** Replaces all starting parentheses of any argument with braces. Useful for initializer generation.*/
 /*#define ENBRACE(...) ITERATE(F_ENBRACE,__VA_ARGS__) //replacing nested pairs is more complicated, requires depth-first search on syntax tree
 #define F_ENBRACE(...) _ENBRACE(STARTSGROUP(__VA_ARGS__),__VA_ARGS__)
@@ -478,6 +586,227 @@
 	IF_ELSE(XNOR(_NAMESPTAKE COND1,_NAMESPTAKE COND2),_NAMESPI(PREFIX,NAMES,_NAMESPDROP(_NAMESPI COND2,)__VA_ARGS__),_NAMESPI(,))
 //I found an XNOR bug with this
 #define IS_EQUAL_DBG(PREFIXES,NAMES,...) _NAMESPDROP(WHILE_DBG(P_NOBLANK,F_IS_EQUAL,PREFIXES,NAMES,__VA_ARGS__))
+/** Batched namespace checks of up to LOOPMAX whole arguments with a single paste per argument instead of a
+ * WHILE loop. Only names defined as blank are members, the NAME_... properties (and forbidden names) make
+ * an argument an offender. NAMESPACE_OFFENDER expands to the first argument which is not in the namespace
+ * with the PREFIX or to blank. IS_NAMESPACE_ALL returns 1, iff all arguments are in the namespace.
+ * NAMESPACE_ASSERT fails at compile-time with the name of the offender:
+ *   #define _CONF_USE_UART
+ *   #define _CONF_USE_SPI
+ *   NAMESPACE_ASSERT(_CONF, USE_UART, USE_SPI, USE_I2C);	//"USE_I2C is not in the namespace _CONF" */
+#define NAMESPACE_OFFENDER(PREFIX,...) _NAMESPTAKE(_NAMESPDROP(_MAPN(ARGNUM(__VA_ARGS__),F_NAMESPOFFENDER,_MAPI0,PREFIX,__VA_ARGS__)))
+#define F_NAMESPOFFENDER(A,PREFIX) IF(PREFIX ## _ ## A,_NAMESPI(, A))
+#define IS_NAMESPACE_ALL(PREFIX,...) NOT(NAMESPACE_OFFENDER(PREFIX,__VA_ARGS__))
+#define NAMESPACE_ASSERT(PREFIX,...) _NAMESPASSERT(PREFIX,NAMESPACE_OFFENDER(PREFIX,__VA_ARGS__))
+#define _NAMESPASSERT(PREFIX,A) _Static_assert(ISBLANK(A), STRING(A) " is not in the namespace " STRING(PREFIX))
+
+/** Resolves feature flags with their dependencies. Macros can't define macros, so every feature is declared
+ * with its own bit (below 64), the features it requires and the ones it conflicts with in the namespace _FEATURE:
+ *   #define _FEATURE_NET FEATURES_DECLARE(0,(SOCKET),(SERIAL))
+ *   #define _FEATURE_SOCKET FEATURES_DECLARE(1,(),())
+ *   #define _FEATURE_SERIAL FEATURES_DECLARE(2,(),(NET))
+ *   #define FEATURES_ENABLED NET
+ *   #if FEATURES_CONFLICT(FEATURES_ENABLED)
+ *   #error "conflicting features"
+ *   #endif
+ *   #if FEATURE(SOCKET)	//true, because NET requires it
+ * FEATURES_RESOLVE(...) is the mask of the enabled features and everything they require transitively, each
+ * WHILE cycle adds one level of requirements. FEATURE(X) tests the bit of X in the mask of FEATURES_ENABLED.
+ * All of them are integer constant expressions for #if and C.
+ * Every feature is expanded only once, a visited vector with one slot per bit drops the features of a level
+ * which were resolved before, so cyclic requirements are fine. A level takes at most 27 features (with
+ * duplicates) and the requirement chains at most LOOPLIMIT levels, otherwise the resolution fails with
+ * FEATURES_LEVEL_EXCEEDS_27_FEATURES. A name without its _FEATURE_ macro, e.g. a typo in FEATURES_ENABLED,
+ * a requirement, a conflict or FEATURE(X), fails with FEATURE_NOT_DECLARED_<name> instead of being false. */
+#define FEATURES_DECLARE(BIT,REQUIRES,CONFLICTS) (BIT,REQUIRES,CONFLICTS)
+#define FEATURE(X) ((FEATURES_RESOLVE(FEATURES_ENABLED) >> _FEATBIT(X) _FEATCHECK(X)) & 1)
+#define FEATURES_RESOLVE(...) _FEATURESMASK(_FEATURES(__VA_ARGS__))
+//the mask of the features which conflict with another enabled feature
+#define FEATURES_CONFLICT(...) _FEATURESCONFLICT(_FEATURES(__VA_ARGS__))
+#define _FEATURES(...) _FEATDROP(_FEATDROP(WHILE(P_FEATURES,F_FEATURES,(__VA_ARGS__),(_FEATEMPTY),,)))
+//65 blank slots, the last one keeps _FEATSET0 from a trailing comma
+#define _FEATEMPTY ,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,
+#define _FEATDROP(...) _DROP0(__VA_ARGS__)
+#define _FEATURESMASK(...) _FEATURESMASK0(__VA_ARGS__)
+#define _FEATURESMASK0(MASK,CONFLICTS) (0ull MASK)
+#define _FEATURESCONFLICT(...) _FEATURESCONFLICT0(__VA_ARGS__)
+#define _FEATURESCONFLICT0(MASK,CONFLICTS) ((0ull MASK) & (0ull CONFLICTS))
+#define _FEATI(...) __VA_ARGS__
+//the state is the parenthesized list of the next level, the visited vector, the mask and the conflict mask
+#define P_FEATURES(LEVEL,...) BOOL(_FEATI LEVEL)
+#define F_FEATURES(LEVEL,VISITED,MASK,CONFLICTS)\
+	_FEATURES0(MASK,CONFLICTS,_TREELOOP(F_FEATNEW,_FEATVISIT,(VISITED,LEVEL,),LEVEL))
+#define _FEATURES0(...) _FEATURES1(__VA_ARGS__)
+//NEW are the features of the level which weren't resolved before, without duplicates
+#define _FEATURES1(MASK,CONFLICTS,AKK,REST,_,...)\
+	(_FEATDROP(_REPEATN(ARGNUM(__VA_ARGS__),F_FEATREQUIRES,_REPEATI0,,__VA_ARGS__))),_TAKE0 AKK,\
+	MASK _FEATOVERFLOW(_FEATI REST) _FEATUNDECLARED AKK _REPEATN(ARGNUM(__VA_ARGS__),F_FEATMASK,_REPEATI0,,__VA_ARGS__),\
+	CONFLICTS _REPEATN(ARGNUM(__VA_ARGS__),F_FEATCONFLICTS,_REPEATI0,,__VA_ARGS__)
+#define _FEATOVERFLOW(...) APPLYIF(__VA_ARGS__,_FEATFAIL,())
+#define _FEATFAIL() FEATURES_LEVEL_EXCEEDS_27_FEATURES ## .
+#define F_FEATNEW(A,AKK) APPLYIF(A,_FEATNEW,(A,_TAKE0 AKK))
+#define _FEATNEW(A,VISITED) IFNOT(_FEATGET(_FEATBIT(A),_FEATI VISITED),I(, A))
+#define _FEATVISIT(AKK) _FEATVISIT0 AKK
+//the accumulator is the visited vector, the rest of the level and the errors of undeclared names
+#define _FEATVISIT0(VISITED,LEVEL,UNDECLARED)\
+	(_FEATVISIT1(VISITED,_TAKE0 LEVEL),(_DROP0 LEVEL),UNDECLARED _FEATVISIT2(_TAKE0 LEVEL))
+#define _FEATVISIT1(VISITED,A) APPLYIF(A,_FEATSET,(_FEATBIT(A),_FEATI VISITED))IFNOT(A,VISITED)
+#define _FEATVISIT2(A) APPLYIF(A,_FEATCHECK,(A))
+#define _FEATUNDECLARED(VISITED,LEVEL,UNDECLARED) UNDECLARED
+#define _FEATGET(BIT,...) CONC(_FEATGET,BIT)(__VA_ARGS__)
+#define _FEATSET(BIT,...) (CONC(_FEATSET,BIT)(__VA_ARGS__))
+//an undeclared name gets bit 0 without requirements, _FEATCHECK reports it
+#define _FEATDECL(X) _FEATDECL0(_FEATURE_ ## X)
+#define _FEATDECL0(DECL) _FEATSELECT(_FEATPAREN DECL,_FEATKNOWN,_FEATUNKNOWN,)(DECL)
+#define _FEATCHECK(X) _FEATCHECK0(X,_FEATURE_ ## X)
+#define _FEATCHECK0(X,DECL) _FEATSELECT(_FEATPAREN DECL,_FEATDECLARED,_FEATNOTDECLARED,)(X)
+//the declaration is a parenthesized list, which turns _FEATPAREN into a comma and shifts the selection
+#define _FEATPAREN(...) ,
+#define _FEATSELECT(...) _FEATSELECT0(__VA_ARGS__)
+#define _FEATSELECT0(A,B,C,...) C
+#define _FEATKNOWN(DECL) _FEATI DECL
+#define _FEATUNKNOWN(DECL) 0,(),()
+#define _FEATDECLARED(X)
+#define _FEATNOTDECLARED(X) FEATURE_NOT_DECLARED_ ## X ## .
+#define _FEATBIT(X) _FEATBIT0(_FEATDECL(X))
+#define _FEATBIT0(...) _TAKE0(__VA_ARGS__)
+#define F_FEATREQUIRES(A,_) _FEATREQUIRES(_FEATDECL(A))
+#define _FEATREQUIRES(...) _FEATREQUIRES0(__VA_ARGS__)
+#define _FEATREQUIRES0(BIT,REQUIRES,CONFLICTS) VARGS(_FEATI REQUIRES)
+#define F_FEATMASK(A,_) | 1ull << _FEATBIT(A)
+#define F_FEATCONFLICTS(A,_) _FEATCONFLICTS(_FEATDECL(A))
+#define _FEATCONFLICTS(...) _FEATCONFLICTS0(__VA_ARGS__)
+#define _FEATCONFLICTS0(BIT,REQUIRES,CONFLICTS) TREELOOP(F_FEATCONFLICTBIT,,,_FEATI CONFLICTS)
+#define F_FEATCONFLICTBIT(A,_) APPLYIF(A,_FEATCONFLICTBIT,(A))
+#define _FEATCONFLICTBIT(A) _FEATCHECK(A) | 1ull << _FEATBIT(A)
+#define _FEATGET63(A,...) _FEATGET62(__VA_ARGS__)
+#define _FEATGET62(A,...) _FEATGET61(__VA_ARGS__)
+#define _FEATGET61(A,...) _FEATGET60(__VA_ARGS__)
+#define _FEATGET60(A,...) _FEATGET59(__VA_ARGS__)
+#define _FEATGET59(A,...) _FEATGET58(__VA_ARGS__)
+#define _FEATGET58(A,...) _FEATGET57(__VA_ARGS__)
+#define _FEATGET57(A,...) _FEATGET56(__VA_ARGS__)
+#define _FEATGET56(A,...) _FEATGET55(__VA_ARGS__)
+#define _FEATGET55(A,...) _FEATGET54(__VA_ARGS__)
+#define _FEATGET54(A,...) _FEATGET53(__VA_ARGS__)
+#define _FEATGET53(A,...) _FEATGET52(__VA_ARGS__)
+#define _FEATGET52(A,...) _FEATGET51(__VA_ARGS__)
+#define _FEATGET51(A,...) _FEATGET50(__VA_ARGS__)
+#define _FEATGET50(A,...) _FEATGET49(__VA_ARGS__)
+#define _FEATGET49(A,...) _FEATGET48(__VA_ARGS__)
+#define _FEATGET48(A,...) _FEATGET47(__VA_ARGS__)
+#define _FEATGET47(A,...) _FEATGET46(__VA_ARGS__)
+#define _FEATGET46(A,...) _FEATGET45(__VA_ARGS__)
+#define _FEATGET45(A,...) _FEATGET44(__VA_ARGS__)
+#define _FEATGET44(A,...) _FEATGET43(__VA_ARGS__)
+#define _FEATGET43(A,...) _FEATGET42(__VA_ARGS__)
+#define _FEATGET42(A,...) _FEATGET41(__VA_ARGS__)
+#define _FEATGET41(A,...) _FEATGET40(__VA_ARGS__)
+#define _FEATGET40(A,...) _FEATGET39(__VA_ARGS__)
+#define _FEATGET39(A,...) _FEATGET38(__VA_ARGS__)
+#define _FEATGET38(A,...) _FEATGET37(__VA_ARGS__)
+#define _FEATGET37(A,...) _FEATGET36(__VA_ARGS__)
+#define _FEATGET36(A,...) _FEATGET35(__VA_ARGS__)
+#define _FEATGET35(A,...) _FEATGET34(__VA_ARGS__)
+#define _FEATGET34(A,...) _FEATGET33(__VA_ARGS__)
+#define _FEATGET33(A,...) _FEATGET32(__VA_ARGS__)
+#define _FEATGET32(A,...) _FEATGET31(__VA_ARGS__)
+#define _FEATGET31(A,...) _FEATGET30(__VA_ARGS__)
+#define _FEATGET30(A,...) _FEATGET29(__VA_ARGS__)
+#define _FEATGET29(A,...) _FEATGET28(__VA_ARGS__)
+#define _FEATGET28(A,...) _FEATGET27(__VA_ARGS__)
+#define _FEATGET27(A,...) _FEATGET26(__VA_ARGS__)
+#define _FEATGET26(A,...) _FEATGET25(__VA_ARGS__)
+#define _FEATGET25(A,...) _FEATGET24(__VA_ARGS__)
+#define _FEATGET24(A,...) _FEATGET23(__VA_ARGS__)
+#define _FEATGET23(A,...) _FEATGET22(__VA_ARGS__)
+#define _FEATGET22(A,...) _FEATGET21(__VA_ARGS__)
+#define _FEATGET21(A,...) _FEATGET20(__VA_ARGS__)
+#define _FEATGET20(A,...) _FEATGET19(__VA_ARGS__)
+#define _FEATGET19(A,...) _FEATGET18(__VA_ARGS__)
+#define _FEATGET18(A,...) _FEATGET17(__VA_ARGS__)
+#define _FEATGET17(A,...) _FEATGET16(__VA_ARGS__)
+#define _FEATGET16(A,...) _FEATGET15(__VA_ARGS__)
+#define _FEATGET15(A,...) _FEATGET14(__VA_ARGS__)
+#define _FEATGET14(A,...) _FEATGET13(__VA_ARGS__)
+#define _FEATGET13(A,...) _FEATGET12(__VA_ARGS__)
+#define _FEATGET12(A,...) _FEATGET11(__VA_ARGS__)
+#define _FEATGET11(A,...) _FEATGET10(__VA_ARGS__)
+#define _FEATGET10(A,...) _FEATGET9(__VA_ARGS__)
+#define _FEATGET9(A,...) _FEATGET8(__VA_ARGS__)
+#define _FEATGET8(A,...) _FEATGET7(__VA_ARGS__)
+#define _FEATGET7(A,...) _FEATGET6(__VA_ARGS__)
+#define _FEATGET6(A,...) _FEATGET5(__VA_ARGS__)
+#define _FEATGET5(A,...) _FEATGET4(__VA_ARGS__)
+#define _FEATGET4(A,...) _FEATGET3(__VA_ARGS__)
+#define _FEATGET3(A,...) _FEATGET2(__VA_ARGS__)
+#define _FEATGET2(A,...) _FEATGET1(__VA_ARGS__)
+#define _FEATGET1(A,...) _FEATGET0(__VA_ARGS__)
+#define _FEATGET0(A,...) A
+#define _FEATSET63(A,...) A, _FEATSET62(__VA_ARGS__)
+#define _FEATSET62(A,...) A, _FEATSET61(__VA_ARGS__)
+#define _FEATSET61(A,...) A, _FEATSET60(__VA_ARGS__)
+#define _FEATSET60(A,...) A, _FEATSET59(__VA_ARGS__)
+#define _FEATSET59(A,...) A, _FEATSET58(__VA_ARGS__)
+#define _FEATSET58(A,...) A, _FEATSET57(__VA_ARGS__)
+#define _FEATSET57(A,...) A, _FEATSET56(__VA_ARGS__)
+#define _FEATSET56(A,...) A, _FEATSET55(__VA_ARGS__)
+#define _FEATSET55(A,...) A, _FEATSET54(__VA_ARGS__)
+#define _FEATSET54(A,...) A, _FEATSET53(__VA_ARGS__)
+#define _FEATSET53(A,...) A, _FEATSET52(__VA_ARGS__)
+#define _FEATSET52(A,...) A, _FEATSET51(__VA_ARGS__)
+#define _FEATSET51(A,...) A, _FEATSET50(__VA_ARGS__)
+#define _FEATSET50(A,...) A, _FEATSET49(__VA_ARGS__)
+#define _FEATSET49(A,...) A, _FEATSET48(__VA_ARGS__)
+#define _FEATSET48(A,...) A, _FEATSET47(__VA_ARGS__)
+#define _FEATSET47(A,...) A, _FEATSET46(__VA_ARGS__)
+#define _FEATSET46(A,...) A, _FEATSET45(__VA_ARGS__)
+#define _FEATSET45(A,...) A, _FEATSET44(__VA_ARGS__)
+#define _FEATSET44(A,...) A, _FEATSET43(__VA_ARGS__)
+#define _FEATSET43(A,...) A, _FEATSET42(__VA_ARGS__)
+#define _FEATSET42(A,...) A, _FEATSET41(__VA_ARGS__)
+#define _FEATSET41(A,...) A, _FEATSET40(__VA_ARGS__)
+#define _FEATSET40(A,...) A, _FEATSET39(__VA_ARGS__)
+#define _FEATSET39(A,...) A, _FEATSET38(__VA_ARGS__)
+#define _FEATSET38(A,...) A, _FEATSET37(__VA_ARGS__)
+#define _FEATSET37(A,...) A, _FEATSET36(__VA_ARGS__)
+#define _FEATSET36(A,...) A, _FEATSET35(__VA_ARGS__)
+#define _FEATSET35(A,...) A, _FEATSET34(__VA_ARGS__)
+#define _FEATSET34(A,...) A, _FEATSET33(__VA_ARGS__)
+#define _FEATSET33(A,...) A, _FEATSET32(__VA_ARGS__)
+#define _FEATSET32(A,...) A, _FEATSET31(__VA_ARGS__)
+#define _FEATSET31(A,...) A, _FEATSET30(__VA_ARGS__)
+#define _FEATSET30(A,...) A, _FEATSET29(__VA_ARGS__)
+#define _FEATSET29(A,...) A, _FEATSET28(__VA_ARGS__)
+#define _FEATSET28(A,...) A, _FEATSET27(__VA_ARGS__)
+#define _FEATSET27(A,...) A, _FEATSET26(__VA_ARGS__)
+#define _FEATSET26(A,...) A, _FEATSET25(__VA_ARGS__)
+#define _FEATSET25(A,...) A, _FEATSET24(__VA_ARGS__)
+#define _FEATSET24(A,...) A, _FEATSET23(__VA_ARGS__)
+#define _FEATSET23(A,...) A, _FEATSET22(__VA_ARGS__)
+#define _FEATSET22(A,...) A, _FEATSET21(__VA_ARGS__)
+#define _FEATSET21(A,...) A, _FEATSET20(__VA_ARGS__)
+#define _FEATSET20(A,...) A, _FEATSET19(__VA_ARGS__)
+#define _FEATSET19(A,...) A, _FEATSET18(__VA_ARGS__)
+#define _FEATSET18(A,...) A, _FEATSET17(__VA_ARGS__)
+#define _FEATSET17(A,...) A, _FEATSET16(__VA_ARGS__)
+#define _FEATSET16(A,...) A, _FEATSET15(__VA_ARGS__)
+#define _FEATSET15(A,...) A, _FEATSET14(__VA_ARGS__)
+#define _FEATSET14(A,...) A, _FEATSET13(__VA_ARGS__)
+#define _FEATSET13(A,...) A, _FEATSET12(__VA_ARGS__)
+#define _FEATSET12(A,...) A, _FEATSET11(__VA_ARGS__)
+#define _FEATSET11(A,...) A, _FEATSET10(__VA_ARGS__)
+#define _FEATSET10(A,...) A, _FEATSET9(__VA_ARGS__)
+#define _FEATSET9(A,...) A, _FEATSET8(__VA_ARGS__)
+#define _FEATSET8(A,...) A, _FEATSET7(__VA_ARGS__)
+#define _FEATSET7(A,...) A, _FEATSET6(__VA_ARGS__)
+#define _FEATSET6(A,...) A, _FEATSET5(__VA_ARGS__)
+#define _FEATSET5(A,...) A, _FEATSET4(__VA_ARGS__)
+#define _FEATSET4(A,...) A, _FEATSET3(__VA_ARGS__)
+#define _FEATSET3(A,...) A, _FEATSET2(__VA_ARGS__)
+#define _FEATSET2(A,...) A, _FEATSET1(__VA_ARGS__)
+#define _FEATSET1(A,...) A, _FEATSET0(__VA_ARGS__)
+#define _FEATSET0(A,...) 1, __VA_ARGS__
 
 
 #define F_INCR(A, ...) IF(A,+1)
@@ -604,7 +933,7 @@
  * */
 /** A division of unary numbers. Using unary numbers it barely gets any more efficient than this. */
 #define DIV(N,M) _DIV(N,M)
-#define _DIV(N,M) _DIVDROP(WHILE(P_NOBLANK,F_DIVIDE,PP0,M,_DIVI N))
+#define _DIV(N,M) _DIVDROP(_WHILEAS(DIV,P_NOBLANK,F_DIVIDE,PP0,M,_DIVI N))
 #define _DIVDROP(...) _DROP0(__VA_ARGS__)
 #define _DIVI(...) __VA_ARGS__
 #define F_DIVIDE(Q,M,...)	_DIV0(DROP_N((__VA_ARGS__),_DIVI M),Q,M,__VA_ARGS__)
@@ -674,7 +1003,7 @@
 //the borrow bit is always the inverted carry bit
 #define DEC_MUL(N,M) TO_DECIMAL(MUL(TO_UNARY(N),TO_UNARY(M)))
 #define DEC_DIV(N,M) COUNT_N(DIV(TO_UNARY(N),TO_UNARY(M)))
-//dividing by zero is an endless loop and expands to blank!
+//dividing by zero is an endless loop and expands to blank! (or fails with MACRO_BUDGET)
 
 
 //expands to the count of arguments represented as unary number
@@ -700,8 +1029,12 @@
  * @param[in] ... - elements of right list. KEEP IN MIND!: if the first element is blank, it is ignored.
  *                  This rule is due to CARTPOW to prevent mapping an additional blank element in a
  *                  subsequent CARTESIAN call which is generated by the previous CARTESIAN call. */
-#define CARTESIAN(CHGARGS,FUNC,CHG,LIST,...) _CARTESIAN(TRY(CHGARGS,_MAPI0),(FUNC,TRY(CHG,_MAPI1),LIST),__VA_ARGS__)
-#define _CARTESIAN(CHGARGS,ARGS,A,...) _CARTESIAN0(ARGNUM(OPT(A)__VA_ARGS__),CHGARGS,ARGS,OPT(A)__VA_ARGS__)
+#define CARTESIAN(CHGARGS,FUNC,CHG,LIST,...) _CARTESIANAS(CARTESIAN,CHGARGS,FUNC,CHG,LIST,__VA_ARGS__)
+//NAME is the macro which is reported when exceeding the MACRO_BUDGET
+#define _CARTESIANAS(NAME,CHGARGS,FUNC,CHG,LIST,...) _BUDGETCUT(NAME,LOOPLIMIT,_CARTESIANI LIST)\
+	_CARTESIAN(NAME,TRY(CHGARGS,_MAPI0),(FUNC,TRY(CHG,_MAPI1),LIST),__VA_ARGS__)
+#define _CARTESIAN(NAME,CHGARGS,ARGS,A,...) _BUDGETCUT(NAME,LOOPMAX,OPT(A)__VA_ARGS__)\
+	_CARTESIAN0(ARGNUM(OPT(A)__VA_ARGS__),CHGARGS,ARGS,OPT(A)__VA_ARGS__)
 #define _CARTESIAN0(COUNT,CHGARGS,ARGS,...) _CARTESIANI(_MAPN(COUNT,F_CARTES,CHGARGS,CHGARGS(ARGS),__VA_ARGS__))
 /* Even though called later, any nested macro name here is flagged as illegal for any later macro expansion.
  * This is the reason why we need indirection. */
@@ -752,10 +1085,10 @@
  * @param[in] LIST - initial (parenthesized) LIST argument
  * @param[in] STARTLIST - parenthesized list which is used as __VA_ARGS__ for the deepest nested call.
  * @param[in] ... - elements which should generate a CARTESIAN call per element */
-#define CARTPOW(GEN,CHGARGS,FUNC,CHG,LIST,STARTLIST,...)\
+#define CARTPOW(GEN,CHGARGS,FUNC,CHG,LIST,STARTLIST,...) _BUDGETCUT(CARTPOW,LOOPMAX,__VA_ARGS__)\
 	_CARTPOW(ARGNUM(__VA_ARGS__),TRY(GEN,_REPEATI0),(TRY(CHGARGS,_REPEATI0),FUNC,TRY(CHG,_REPEATI1),LIST),_REPEATI0 STARTLIST,__VA_ARGS__)
 #define _CARTPOW(COUNT,GEN,ARGS,START,...) _CARTPOWI(_REPEATN(COUNT,F_CARTPOW,GEN,ARGS,__VA_ARGS__) START _REPEATN(COUNT,F_RPAR,_REPEATI0,,))
-#define F_CARTPOW(_,ARGS) CARTESIAN _LPAR _CARTPOWI ARGS ,
+#define F_CARTPOW(_,ARGS) _CARTESIANAS _LPAR CARTPOW, _CARTPOWI ARGS ,
 #define _CARTPOWI(...) __VA_ARGS__
 
 /** enumerates all binary literals from 2^N-1 down to 0. N must be a decimal literal for safety reasons. */
@@ -764,6 +1097,54 @@
 #define _ENUMBINDROP(...) RCARTCAT((_DROP0(__VA_ARGS__)),0b)
 #define _ENUMBINI(...) __VA_ARGS__
 
+/** Enumerates a window of M consecutive tuples of the Cartesian product of N parenthesized lists without
+ * expanding the product before it. Like in CARTESIAN, the first list varies fastest. So the index of
+ * a tuple is the mixed-radix number k = d1 + |L1|*(d2 + |L2|*(d3 + ...)) and its digits di directly
+ * select the elements. The cost is linear in M*N, no matter how big k is.
+ * @param[in] FUNC - is called with the elements of each tuple, the expansions are separated with commas.
+ *                   If FUNC is blank, each tuple is expanded in parentheses.
+ * @param[in] START - parenthesized digits (d1,...,dN) of the first tuple with di < |Li|. Missing upper
+ *                    digits are 0, so () starts with the first tuple.
+ * @param[in] M - decimal literal <= LOOPMAX. The window ends early after the last tuple of the product.
+ * @param[in] ... - the parenthesized lists L1,...,LN. Their elements must not be blank.
+ * Like in CARTESIAN, FUNC must not call _REPEAT based macros. */
+#define CARTWINDOW(FUNC,START,M,...)\
+	_CARTWINDROP(_REPEATN(M,F_CARTWIN,_CARTWINSTEP,(TRY(FUNC,_CARTWINTUPLE),,_CARTWINSTART(START,__VA_ARGS__)),))
+/** expands to the parenthesized digits of the first tuple after CARTWINDOW(FUNC,START,M,...) which are
+ * the START for the next window, or to blank if the window already reached the end of the product. */
+#define CARTWINDOW_NEXT(START,M,...) _CARTWINDIGITS(LOOP(_CARTWINNEXT,M,_CARTWINTUPLE,,_CARTWINSTART(START,__VA_ARGS__)))
+#define _CARTWINDROP(...) _DROP0(__VA_ARGS__)
+#define _CARTWINI(...) __VA_ARGS__
+#define _CARTWINTUPLE(...) (__VA_ARGS__)
+//every dimension is represented as ((remaining elements),(all elements)), the first remaining element is current
+#define _CARTWINSTART(START,...) _CARTWINDROP(_MAPN(ARGNUM(__VA_ARGS__),F_CARTWINSTART,_CARTWINSTARTDROP,(_CARTWINI START),__VA_ARGS__))
+#define F_CARTWINSTART(A,DIGITS) , ((DROPN(TRY(_TAKE0 DIGITS,0),_CARTWINI A)),A)
+#define _CARTWINSTARTDROP(DIGITS) (_DROP0 DIGITS)
+#define F_CARTWIN(_,STATE) APPLYIFNOT(_CARTWINENDED STATE,_CARTWIN0,STATE)
+#define _CARTWINENDED(FUNC,ENDED,...) ENDED
+#define _CARTWIN0(FUNC,ENDED,...) , _CARTWIN1(FUNC,_CARTWINDROP(_MAPN(ARGNUM(__VA_ARGS__),F_CARTWINELEM,_MAPI0,,__VA_ARGS__)))
+#define _CARTWIN1(FUNC,...) FUNC(__VA_ARGS__)
+#define F_CARTWINELEM(A,_) , _CARTWINELEM0 A
+#define _CARTWINELEM0(REST,ALL) _TAKE0 REST
+#define _CARTWINSTEP(STATE) (_CARTWINNEXT STATE)
+//increments the lowest digit, the carry is passed from one dimension to the next by the CHG function of _MAP
+#define _CARTWINNEXT(FUNC,ENDED,...) FUNC,BOOL(ENDED NOT(_MAPN(ARGNUM(__VA_ARGS__),F_CARTWINNOTLAST,_MAPI0,,__VA_ARGS__))),\
+	_CARTWINDROP(_MAPN(ARGNUM(__VA_ARGS__),F_CARTWININC,_CARTWINCARRY,(1,__VA_ARGS__),__VA_ARGS__))
+#define F_CARTWINNOTLAST(A,_) _CARTWINNOTLAST0 A
+#define _CARTWINNOTLAST0(REST,ALL) BOOL(_DROP0 REST)
+#define F_CARTWININC(A,ARGS) , _CARTWININC0(_TAKE0 ARGS,A)
+#define _CARTWININC0(CARRY,DIM) IF_ELSE(CARRY,_CARTWININC1 DIM,DIM)
+#define _CARTWININC1(REST,ALL) _CARTWININC2(BOOL(_DROP0 REST),REST,ALL)
+#define _CARTWININC2(COND,REST,ALL) IF_ELSE(COND,((_DROP0 REST),ALL),(ALL,ALL))
+#define _CARTWINCARRY(ARGS) _CARTWINCARRY0 ARGS
+#define _CARTWINCARRY0(CARRY,A,...) (AND(CARRY,_CARTWINISLAST A),__VA_ARGS__)
+#define _CARTWINISLAST(REST,ALL) NOT(_DROP0 REST)
+#define _CARTWINDIGITS(...) _CARTWINDIGITS0(__VA_ARGS__)
+#define _CARTWINDIGITS0(FUNC,ENDED,...) IFNOT(ENDED,(_CARTWINDROP(_MAPN(ARGNUM(__VA_ARGS__),F_CARTWINDIGIT,_MAPI0,,__VA_ARGS__))))
+//the digit is the number of elements before the current one
+#define F_CARTWINDIGIT(A,_) , _CARTWINDIGIT0 A
+#define _CARTWINDIGIT0(REST,ALL) ARGNUM(DROP_N(REST,_CARTWINI ALL))
+
 #define BIN(D) IFNOT(_BIN BIN_##D,BIN_##D)
 #define _BIN(...)
 #define BIN_0 PP0
@@ -798,4 +1179,61 @@
 #define F_UNDERSCORE(A,...) _ ## A ## _
 #define F_DECORATE(A,...) .~*+A+*~
 
+/** Lite mode for IDEs and indexers: their preprocessors are slow on the long loop expansions and tend to
+ * time out or show wrong errors. In lite mode LOOPLIMIT is PP12, so WHILE runs at most 12 cycles and the
+ * loops without a count like FILTER, CONCAT and STRMAP cut their lists after 12 elements, MAP, REDUCE and
+ * the other loops counting their list with ARGNUM keep up to LOOPMAX elements. 12 cycles still fit WHILE
+ * over ten names and the decimal digit lists, with fewer cycles the long examples turn into wrong errors.
+ * The heavy generators expand to cheap placeholders: the cartesian macros (which decide about the commas
+ * themselves through FUNC) expand to blank, CARTCAT, RCARTCAT and CONCNUMS to as many zeros as the product
+ * has elements (within the cut after LOOPLIMIT elements per list), CARTWINDOW to M zeros, ENUMBIN and
+ * FLATTEN to a single 0 and the multiplication and division to 1 resp. PP1, so that they can still be
+ * passed to other macros. It is switched on for Eclipse CDT (e.g. Atollic), Visual Studio IntelliSense and
+ * JetBrains automatically, other indexers like clangd need -DMACRO_LITE (any value but 0, even blank).
+ * Define MACRO_LITE as 0 to disable it. Never compile with lite mode, the results are wrong. */
+/** size hint for lite mode: expands to __VA_ARGS__ and in lite mode to N (<=LOOPMAX) zeros instead, e.g.
+ *   int digits[] = {LITE_SIZE(10,FILTER(F_ISDEC,HEXADEC))};
+ * keeps sizeof(digits) in the IDE for generators without an own placeholder. */
+#if _LITE
+#define LITE_SIZE(N,...) REPEATN(N,0)
+#undef CARTESIAN
+#define CARTESIAN(CHGARGS,FUNC,CHG,LIST,...)
+#undef CARTMAP
+#define CARTMAP(FUNC,LIST,...)
+#undef CARTPOW
+#define CARTPOW(GEN,CHGARGS,FUNC,CHG,LIST,STARTLIST,...)
+#undef CARTWINDOW_NEXT
+#define CARTWINDOW_NEXT(START,M,...)
+#undef CARTWINDOW
+#define CARTWINDOW(FUNC,START,M,...) REPEATN(M,0)
+#undef CARTCAT
+#define CARTCAT(LIST,...) _LITEPRODUCT(LIST,__VA_ARGS__)
+#undef RCARTCAT
+#define RCARTCAT(LIST,...) _LITEPRODUCT(LIST,__VA_ARGS__)
+#undef CONCNUMS
+#define CONCNUMS(LIST,...) _LITEPRODUCT(LIST,__VA_ARGS__)
+//one zero for each pair of the Cartesian product, both lists are cut after LOOPLIMIT elements like in _CARTMAP
+#define _LITEPRODUCT(LIST,...) _LITEDROP(_MAP(F_LITEPRODUCT,_MAPI0,LIST,__VA_ARGS__))
+#define F_LITEPRODUCT(A,LIST) _REPEAT(F_LITEZERO,_MAPI0,,_LITEI LIST)
+#define F_LITEZERO(A,_) IF(A,I(, 0))
+#define _LITEDROP(...) _DROP0(__VA_ARGS__)
+#define _LITEI(...) __VA_ARGS__
+#undef ENUMBIN
+#define ENUMBIN(N) 0
+#undef FLATTEN
+#define FLATTEN(...) 0
+#undef FLATTEN_DEPTH
+#define FLATTEN_DEPTH(N,...) 0
+#undef MUL
+#define MUL(N,M) PP1
+#undef DIV
+#define DIV(N,M) PP1
+#undef DEC_MUL
+#define DEC_MUL(N,M) 1
+#undef DEC_DIV
+#define DEC_DIV(N,M) 1
+#else
+#define LITE_SIZE(N,...) __VA_ARGS__
+#endif
+
 #endif 
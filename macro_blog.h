@@ -0,0 +1,128 @@
+/** Binary logging with Preprocessor */
+//log calls only copy the raw arguments, the formatting is deferred until the log is flushed
+
+#ifndef MACRO_BLOG_H
+#define MACRO_BLOG_H
+#include <stdio.h>
+#include <string.h>
+#include "macro_api.h"
+
+/** BLOG(FMT,...) logs like printf into a ring buffer of the calling thread, but it only stores the address of
+ * the static record of the call site, whose type descriptor has been derived from the arguments with _Generic
+ * at compile-time, and the raw bytes of the arguments. blog_flush(f) formats the entries of the calling thread
+ * later and empties the buffer:
+ *   BLOG("sensor %d: %f\n", id, value);
+ *   ...
+ *   blog_flush(stderr);
+ * Arguments are integers, floating point numbers (long double too, printed with %Lf) and pointers, at most
+ * LOOPMAX. A char pointer is printed as string, so it has to stay valid until the flush like a string literal.
+ * Entries which don't fit into the BLOG_SIZE bytes (a power of two) of the buffer are dropped and counted.
+ * The format is checked against the arguments like printf (-Wformat), but a * width or precision isn't
+ * supported, because the entry doesn't keep which argument it belongs to: blog_flush prints such a
+ * conversion as is and skips its arguments. */
+#ifndef BLOG_SIZE
+#define BLOG_SIZE 4096
+#endif
+struct blog_site { const char *fmt, *file; int line; const char *types; };
+struct blog_ring { size_t head, tail, dropped; unsigned char buf[BLOG_SIZE]; };
+//weak, so all translation units share one buffer per thread
+_Thread_local struct blog_ring blog_ring __attribute__((weak));
+
+#define BLOG(FMT,...) MACRO(\
+	if (0) printf(FMT, ##__VA_ARGS__);\
+	static const char NAME(blogtypes)[] = {MAP(F_BLOGTYPE,__VA_ARGS__) 0};\
+	static const struct blog_site NAME(blogsite) = {FMT, __FILE__, __LINE__, NAME(blogtypes)};\
+	unsigned char _blog_entry[sizeof(void *) + sizeof(NAME(blogtypes)) * sizeof(long double)], *_blog_p = _blog_entry;\
+	_blog_put_p(&_blog_p, &NAME(blogsite));\
+	MAP(F_BLOGPUT,__VA_ARGS__)\
+	_blog_commit(_blog_entry, (size_t)(_blog_p - _blog_entry));\
+	)
+#define F_BLOGTYPE(A,...) _Generic((A), _Bool: 'u', char: 'i', signed char: 'i', unsigned char: 'u', short: 'i',\
+	unsigned short: 'u', int: 'i', unsigned: 'u', long: 'l', unsigned long: 'm', long long: 'L',\
+	unsigned long long: 'M', float: 'd', double: 'd', long double: 'D', char *: 's', const char *: 's', default: 'p'),
+#define F_BLOGPUT(A,...) _Generic((A), _Bool: _blog_put_u, char: _blog_put_i, signed char: _blog_put_i,\
+	unsigned char: _blog_put_u, short: _blog_put_i, unsigned short: _blog_put_u, int: _blog_put_i,\
+	unsigned: _blog_put_u, long: _blog_put_l, unsigned long: _blog_put_m, long long: _blog_put_L,\
+	unsigned long long: _blog_put_M, float: _blog_put_d, double: _blog_put_d, long double: _blog_put_D, default: _blog_put_p)(&_blog_p, A);
+#define _BLOGPUT(SUFFIX,T) static inline void CONC(_blog_put_,SUFFIX)(unsigned char **p, T v) { memcpy(*p, &v, sizeof v); *p += sizeof v; }
+_BLOGPUT(i,int)
+_BLOGPUT(u,unsigned)
+_BLOGPUT(l,long)
+_BLOGPUT(m,unsigned long)
+_BLOGPUT(L,long long)
+_BLOGPUT(M,unsigned long long)
+_BLOGPUT(d,double)
+_BLOGPUT(D,long double)
+_BLOGPUT(p,const void *)
+
+static inline void _blog_commit(const unsigned char *e, size_t n) {
+	struct blog_ring *r = &blog_ring;
+	size_t at = r->head & (BLOG_SIZE - 1), first = BLOG_SIZE - at < n ? BLOG_SIZE - at : n;
+	if (BLOG_SIZE - (r->head - r->tail) < n) {
+		r->dropped++;
+		return;
+	}
+	memcpy(r->buf + at, e, first);
+	memcpy(r->buf, e + first, n - first);
+	r->head += n;
+}
+static inline void _blog_get(struct blog_ring *r, void *v, size_t n) {
+	size_t at = r->tail & (BLOG_SIZE - 1), first = BLOG_SIZE - at < n ? BLOG_SIZE - at : n;
+	memcpy(v, r->buf + at, first);
+	memcpy((unsigned char *)v + first, r->buf, n - first);
+	r->tail += n;
+}
+//prints the next argument of type T with the conversion SPEC, or skips it if SPEC is 0
+#define _BLOGPRINT(T) { T v; _blog_get(r, &v, sizeof v); if (spec) fprintf(f, spec, v); } break;
+static inline void _blog_arg(struct blog_ring *r, FILE *f, const char *spec, char type) {
+	switch (type) {
+	case 'i': _BLOGPRINT(int)
+	case 'u': _BLOGPRINT(unsigned)
+	case 'l': _BLOGPRINT(long)
+	case 'm': _BLOGPRINT(unsigned long)
+	case 'L': _BLOGPRINT(long long)
+	case 'M': _BLOGPRINT(unsigned long long)
+	case 'd': _BLOGPRINT(double)
+	case 'D': _BLOGPRINT(long double)
+	case 's': _BLOGPRINT(const char *)
+	default: _BLOGPRINT(const void *)
+	}
+}
+static inline void blog_flush(FILE *f) {
+	struct blog_ring *r = &blog_ring;
+	while (r->tail != r->head) {
+		const struct blog_site *s;
+		_blog_get(r, &s, sizeof s);
+		const char *c = s->fmt, *t = s->types;
+		while (*c)
+			if (*c != '%' || c[1] == '%') {
+				fputc(*c, f);
+				c += 1 + (*c == '%');
+			} else {
+				char spec[32];
+				size_t n = strcspn(c + 1, "diouxXeEfFgGaAcsp") + 2;
+				if (n > sizeof spec - 1)
+					n = sizeof spec - 1;
+				memcpy(spec, c, n);
+				spec[n] = 0;
+				c += strnlen(c, n);
+				if (strchr(spec, '*')) {
+					for (const char *star = spec; (star = strchr(star, '*')) && *t; star++)
+						_blog_arg(r, f, 0, *t++);
+					if (*t)
+						_blog_arg(r, f, 0, *t++);
+					fputs(spec, f);
+				} else if (*t)
+					_blog_arg(r, f, spec, *t++);
+				else
+					fputs(spec, f);
+			}
+		while (*t)
+			_blog_arg(r, f, 0, *t++);
+	}
+	if (r->dropped)
+		fprintf(f, "%zu log entries dropped\n", r->dropped);
+	r->dropped = 0;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/** Throughput benchmark of the CODEC pack and unpack functions against a per field switch serializer */
+//gcc -O2 macro_codec_bench.c && ./a.out [passes]
+//a telemetry record of 15 wire bytes is packed and unpacked in arrays, in the little endian layout of the host,
+//in the big endian layout and by a reflection style loop over a field descriptor table
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+#define N 4096
+#define FIELDS (uint64_t,time),(uint32_t,sensor),(int16_t,value),(uint8_t,flags)
+CODEC(sample,FIELDS);
+CODEC_BE(sample_be,FIELDS);
+
+//the serializer CODEC replaces, one switch on the size per field
+static const struct { size_t off, size; } fields[] = {
+	{offsetof(struct sample, time), 8}, {offsetof(struct sample, sensor), 4},
+	{offsetof(struct sample, value), 2}, {offsetof(struct sample, flags), 1},
+};
+__attribute__((noinline)) static void generic_pack_n(unsigned char *out, const struct sample *v, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		for (size_t f = 0; f < sizeof fields / sizeof *fields; f++) {
+			const unsigned char *src = (const unsigned char *)(v + i) + fields[f].off;
+			switch (fields[f].size) {
+			case 8: { uint64_t x; memcpy(&x, src, 8); memcpy(out, &x, 8); break; }
+			case 4: { uint32_t x; memcpy(&x, src, 4); memcpy(out, &x, 4); break; }
+			case 2: { uint16_t x; memcpy(&x, src, 2); memcpy(out, &x, 2); break; }
+			case 1: *out = *src; break;
+			}
+			out += fields[f].size;
+		}
+}
+__attribute__((noinline)) static void generic_unpack_n(struct sample *v, const unsigned char *in, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		for (size_t f = 0; f < sizeof fields / sizeof *fields; f++) {
+			unsigned char *dst = (unsigned char *)(v + i) + fields[f].off;
+			switch (fields[f].size) {
+			case 8: { uint64_t x; memcpy(&x, in, 8); memcpy(dst, &x, 8); break; }
+			case 4: { uint32_t x; memcpy(&x, in, 4); memcpy(dst, &x, 4); break; }
+			case 2: { uint16_t x; memcpy(&x, in, 2); memcpy(dst, &x, 2); break; }
+			case 1: *dst = *in; break;
+			}
+			in += fields[f].size;
+		}
+}
+
+static struct sample src[N], dst[N];
+static struct sample_be src_be[N], dst_be[N];
+static unsigned char wire[N * sample_WIRE_SIZE], wire_be[N * sample_WIRE_SIZE], wire_generic[N * sample_WIRE_SIZE];
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+//nanoseconds per record of the passes over the array
+#define TIME(PASSES,...) ({\
+	double start = seconds();\
+	for (long k = 0; k < (PASSES); k++) {\
+		__VA_ARGS__;\
+		__asm__ volatile("" ::: "memory");\
+	}\
+	(seconds() - start) / (PASSES) / N * 1e9;\
+	})
+
+int main(int argc, char **argv) {
+	long passes = argc > 1 ? strtol(argv[1], NULL, 10) : 20000;
+	for (int i = 0; i < N; i++) {
+		src[i] = (struct sample){.time = 1000000007ull * i, .sensor = i * 37, .value = i - N / 2, .flags = i};
+		src_be[i] = (struct sample_be){src[i].time, src[i].sensor, src[i].value, src[i].flags};
+	}
+	printf("pack:   CODEC %.2f ns, CODEC_BE %.2f ns, field switch %.2f ns per record\n",
+		TIME(passes, sample_pack_n(wire, src, N)), TIME(passes, sample_be_pack_n(wire_be, src_be, N)),
+		TIME(passes, generic_pack_n(wire_generic, src, N)));
+	printf("unpack: CODEC %.2f ns, CODEC_BE %.2f ns, field switch %.2f ns per record\n",
+		TIME(passes, sample_unpack_n(dst, wire, N)), TIME(passes, sample_be_unpack_n(dst_be, wire_be, N)),
+		TIME(passes, generic_unpack_n(dst, wire_generic, N)));
+	//on a little endian host the field switch writes the same bytes, and every round trip has to be exact
+	if (memcmp(wire, wire_generic, sizeof wire) || wire_be[sample_WIRE_SIZE + sample_be_OFF_time + 7] != (unsigned char)src[1].time) {
+		fprintf(stderr, "the wire layouts differ\n");
+		return 1;
+	}
+	for (int i = 0; i < N; i++)
+		if (dst[i].time != src[i].time || dst[i].sensor != src[i].sensor || dst[i].value != src[i].value || dst[i].flags != src[i].flags
+			|| dst_be[i].time != src[i].time || dst_be[i].sensor != src[i].sensor || dst_be[i].value != src[i].value
+			|| dst_be[i].flags != src[i].flags) {
+			fprintf(stderr, "record %d differs after the round trip\n", i);
+			return 1;
+		}
+	return 0;
+}
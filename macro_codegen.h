@@ -0,0 +1,361 @@
+/** Code generators with Preprocessor */
+//they expand to C declarations and definitions and are built on the functional programming API
+
+#ifndef MACRO_CODEGEN_H
+#define MACRO_CODEGEN_H
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#if __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define CODEGEN_ATOMICS 1
+#else
+#define CODEGEN_ATOMICS 0
+#endif
+#include "macro_api.h"
+#define _GENI(...) __VA_ARGS__
+
+/** Stamps out one static inline function per type of the parenthesized TYPES list. The macro DEF(FNAME,T)
+ * must expand to the function definition with the name FNAME for the type T, e.g.
+ *   #define SUM(FNAME,T) T FNAME(const T *x, int n) { T s = 0; while(n--) s += *x++; return s; }
+ *   GENERIC_KERNEL(sum,(int,float),SUM)
+ * defines sum_int and sum_float. The type names must be identifiers because they become the name suffix,
+ * use typedefs for the other types. */
+#define GENERIC_KERNEL(NAME,TYPES,DEF) _MAPN(ARGNUM(_GENI TYPES),F_GENERIC_KERNEL,_MAPI0,(NAME,DEF),_GENI TYPES)
+#define F_GENERIC_KERNEL(T,ARGS) _GENERIC_KERNEL0(T,_TAKE0 ARGS,_DROP0 ARGS)
+#define _GENERIC_KERNEL0(T,NAME,DEF) static inline DEF(CONC(NAME,_ ## T),T)
+/** selects the specialization of GENERIC_KERNEL by the type of SEL at compile-time. SEL is not evaluated.
+ * Macros can't define macros, so write the dispatcher macro with the name of the kernel yourself:
+ *   #define sum(X,...) GENERIC_DISPATCH(sum,(int,float),*(X))(X,__VA_ARGS__)
+ * Then sum(x,n) directly calls the specialized function without any runtime switch. */
+#define GENERIC_DISPATCH(NAME,TYPES,SEL) _Generic((SEL) _MAPN(ARGNUM(_GENI TYPES),F_GENERIC_CASE,_MAPI0,NAME,_GENI TYPES))
+#define F_GENERIC_CASE(T,NAME) , T: CONC(NAME,_ ## T)
+
+/** Generates the dispatch of a threaded interpreter or state machine from the list of its states. With GCC,
+ * every state is a label which is jumped to through a static table of label addresses (labels as values),
+ * so every state ends with its own indirect branch which predicts much better than the single jump of a
+ * switch. Without GCC or with DISPATCH_SWITCH defined, the same code expands to a portable switch.
+ *   DISPATCH_ENUM(op,(push,add,halt));         //at file scope: enum op {op_push, op_add, op_halt, op_COUNT}
+ *   int run(const unsigned char *pc) {
+ *     DISPATCH_TABLE(op,(push,add,halt))       //at the beginning of the block
+ *     #define NEXT() DISPATCH_NEXT(op,*pc++)   //macros can't define macros, write NEXT() yourself
+ *     DISPATCH_BEGIN(op,*pc++)
+ *     DISPATCH_CASE(op,push) ... NEXT();
+ *     DISPATCH_CASE(op,add) ... NEXT();
+ *     DISPATCH_CASE(op,halt) return ...;
+ *     DISPATCH_END(op)
+ *   }
+ * The state index is not checked against op_COUNT. A state falls through to the next one without NEXT(). */
+#define DISPATCH_ENUM(NAME,STATES) enum NAME {_MAPN(ARGNUM(_GENI STATES),F_DISPATCH_ENUM,_MAPI0,NAME,_GENI STATES) CONC(NAME,_COUNT)}
+#define F_DISPATCH_ENUM(S,NAME) CONC(NAME,_ ## S),
+#if defined(__GNUC__) && !defined(DISPATCH_SWITCH)
+#define DISPATCH_THREADED 1
+//the local label declaration allows for multiple dispatchers with equal names in one function
+#define DISPATCH_TABLE(NAME,STATES)\
+	__label__ _DISPATCHDROP(_MAPN(ARGNUM(_GENI STATES),F_DISPATCH_LABEL,_MAPI0,NAME,_GENI STATES));\
+	static void *const CONC(NAME,_labels)[] = {_DISPATCHDROP(_MAPN(ARGNUM(_GENI STATES),F_DISPATCH_ADDR,_MAPI0,NAME,_GENI STATES))};
+#define DISPATCH_BEGIN(NAME,EXPR) goto *CONC(NAME,_labels)[(EXPR)];
+#define DISPATCH_CASE(NAME,S) CONC(NAME,_L_ ## S):
+#define DISPATCH_NEXT(NAME,EXPR) goto *CONC(NAME,_labels)[(EXPR)]
+#define DISPATCH_END(NAME)
+#else
+#define DISPATCH_THREADED 0
+#define DISPATCH_TABLE(NAME,STATES) int CONC(NAME,_state);
+#define DISPATCH_BEGIN(NAME,EXPR) CONC(NAME,_state) = (EXPR); CONC(NAME,_dispatch): switch(CONC(NAME,_state)) {
+#define DISPATCH_CASE(NAME,S) case CONC(NAME,_ ## S):
+#define DISPATCH_NEXT(NAME,EXPR) MACRO(CONC(NAME,_state) = (EXPR); goto CONC(NAME,_dispatch);)
+#define DISPATCH_END(NAME) }
+#endif
+#define _DISPATCHDROP(...) _DROP0(__VA_ARGS__)
+#define F_DISPATCH_LABEL(S,NAME) , CONC(NAME,_L_ ## S)
+#define F_DISPATCH_ADDR(S,NAME) , &&CONC(NAME,_L_ ## S)
+
+/** Fully unrolled evaluation of the polynomial c0 + c1*X + c2*X^2 + ... with the coefficients in ascending
+ * order, at most LOOPMAX. X is evaluated several times, so it must not have side effects. Each step is a multiply-add
+ * POLY_FMA(A,B,C) = A*B+C, define it before the inclusion e.g. as __builtin_fma (or __builtin_fmaf for float)
+ * to get fused multiply-adds. Horner needs the fewest operations but every step waits for the previous one:
+ *   POLY_HORNER(x,1,2,3) is POLY_FMA(POLY_FMA(3,(x),2),(x),1) */
+#ifndef POLY_FMA
+#define POLY_FMA(A,B,C) ((A)*(B)+(C))
+#endif
+#define POLY_HORNER(X,...) _POLYHORNER(X,REVERSE(__VA_ARGS__))
+#define _POLYHORNER(X,...) _POLYHORNERDROP(WHILE(P_POLYHORNER,F_POLYHORNER,(X),__VA_ARGS__))
+#define _POLYHORNERDROP(...) _POLYHORNERDROP0(__VA_ARGS__)
+#define _POLYHORNERDROP0(X,ACC,...) ACC
+//the highest coefficient initializes the accumulator ACC, every cycle takes two coefficients
+#define P_POLYHORNER(X,ACC,...) BOOL(__VA_ARGS__)
+#define F_POLYHORNER(X,ACC,C,...) _POLYHORNERNEXT(X,POLY_FMA(ACC,X,C),__VA_ARGS__)
+#define _POLYHORNERNEXT(X,ACC,...) APPLYIF(_GENI(__VA_ARGS__),_POLYHORNERSTEP,(X,ACC,__VA_ARGS__))IFNOT(_GENI(__VA_ARGS__),I(X,ACC,))
+#define _POLYHORNERSTEP(X,ACC,C,...) X,POLY_FMA(ACC,X,C),__VA_ARGS__
+/** Estrin's scheme computes the same polynomial as a balanced tree of the independent pairs c0+c1*X,
+ * c2+c3*X,..., which are combined with X^2, then with X^4 and so on (the pairing of TREE_REDUCE). The powers are recomputed by
+ * squaring in every level, the compiler shares them:
+ *   POLY_ESTRIN(x,1,2,3,4) is POLY_FMA(POLY_FMA(4,(x),3),((x)*(x)),POLY_FMA(2,(x),1)) */
+#define POLY_ESTRIN(X,...) _TREEDROP(_TREEDROP(WHILE(P_TREE,F_POLYESTRIN,_POLYESTRINPAIR,(X),__VA_ARGS__)))
+#define F_POLYESTRIN(COMB,X,...) COMB,(X*X) _REPEATN(ARGNUM(__VA_ARGS__),F_TREEPAIR,_TREESTEP,(COMB,X,__VA_ARGS__),)
+#define _POLYESTRINPAIR(X,A,B) POLY_FMA(B,X,A)
+
+/** Declares a set of up to LOOPMAX flags. Each flag gets the bit of its index in the list, so tests and
+ * updates are single bit operations instead of string compares or bool arrays.
+ *   FLAGSET(opt,verbose,dry,force)
+ * gives the type opt_t (uint32_t, FLAGSET_T chooses another integer type), the masks opt_verbose,
+ * opt_dry and opt_force, opt_ALL with all of them, opt_COUNT = 3, the helpers opt_set, opt_clear,
+ * opt_test (if any of the flags is set) and opt_union and opt_name(bit) with the flag name for logging. */
+#define FLAGSET(NAME,...) FLAGSET_T(NAME,uint32_t,__VA_ARGS__)
+#define FLAGSET_T(NAME,TYPE,...)\
+	typedef TYPE CONC(NAME,_t);\
+	enum CONC(NAME,_flags) {_MAPN(ARGNUM(__VA_ARGS__),F_FLAGSET_BIT,_FLAGSETNEXT,(NAME,PP0),__VA_ARGS__)\
+		CONC(NAME,_COUNT) = ARGNUM(__VA_ARGS__), CONC(NAME,_ALL) = (1 << ARGNUM(__VA_ARGS__)) - 1};\
+	static inline CONC(NAME,_t) CONC(NAME,_set)(CONC(NAME,_t) s, CONC(NAME,_t) f) { return s | f; }\
+	static inline CONC(NAME,_t) CONC(NAME,_clear)(CONC(NAME,_t) s, CONC(NAME,_t) f) { return s & (CONC(NAME,_t))~f; }\
+	static inline int CONC(NAME,_test)(CONC(NAME,_t) s, CONC(NAME,_t) f) { return (s & f) != 0; }\
+	static inline CONC(NAME,_t) CONC(NAME,_union)(CONC(NAME,_t) a, CONC(NAME,_t) b) { return a | b; }\
+	static inline const char *CONC(NAME,_name)(unsigned bit) {\
+		static const char *const names[] = {_MAPN(ARGNUM(__VA_ARGS__),F_FLAGSET_NAME,_MAPI0,,__VA_ARGS__)};\
+		return bit < CONC(NAME,_COUNT) ? names[bit] : "";\
+	}\
+	FAIL_IF(CONC(NAME,_COUNT) > 8*sizeof(TYPE), NAME has more flags than bits in TYPE)
+#define F_FLAGSET_BIT(A,ARGS) _FLAGSETBIT(A,_TAKE0 ARGS,_DROP0 ARGS)
+#define _FLAGSETBIT(A,NAME,IDX) CONC(NAME,_ ## A) = 1 << COUNT_N(IDX),
+#define _FLAGSETNEXT(ARGS) _FLAGSETNEXT0 ARGS
+#define _FLAGSETNEXT0(NAME,IDX) (NAME,ADD_ONE(IDX))
+#define F_FLAGSET_NAME(A,_) STRING(A),
+
+/** Declares a static pool of COUNT blocks of type T for allocations of fixed size without malloc. The
+ * blocks are a union of the object, its TYPE(sizeof(T)) blob and the link of the intrusive free list,
+ * so they are aligned for T and a free block costs no extra memory. A block takes at least a pointer.
+ *   POOL(msgpool,struct msg,64)
+ *   struct msg *m = msgpool_alloc();	//0 if all blocks are in use
+ *   msgpool_free(m);
+ * Both are O(1): freed blocks are reused first, the unused blocks are taken in order, so the pool needs
+ * no initialization. With C11 atomics, msgpool_alloc_atomic and msgpool_free_atomic do the same under a
+ * spin lock for multiple threads. Don't mix them with the unlocked ones while other threads use the pool. */
+#define POOL(NAME,T,COUNT)\
+	typedef union CONC(NAME,_block) { T obj; TYPE(sizeof(T)) blob; union CONC(NAME,_block) *next; } CONC(NAME,_block_t);\
+	static struct { CONC(NAME,_block_t) *free; uint32_t used; _POOLLOCK CONC(NAME,_block_t) blocks[COUNT]; } CONC(NAME,_pool);\
+	static inline T *CONC(NAME,_alloc)(void) {\
+		CONC(NAME,_block_t) *b = CONC(NAME,_pool).free;\
+		if (b)\
+			CONC(NAME,_pool).free = b->next;\
+		else if (CONC(NAME,_pool).used < (COUNT))\
+			b = &CONC(NAME,_pool).blocks[CONC(NAME,_pool).used++];\
+		return (T *)b;\
+	}\
+	static inline void CONC(NAME,_free)(T *p) {\
+		CONC(NAME,_block_t) *b = (CONC(NAME,_block_t) *)p;\
+		b->next = CONC(NAME,_pool).free;\
+		CONC(NAME,_pool).free = b;\
+	}\
+	_POOLATOMIC(NAME,T)\
+	FAIL_IFNOT((COUNT) > 0 && (COUNT) <= UINT32_MAX, NAME needs 1 to UINT32_MAX blocks)
+#if CODEGEN_ATOMICS
+#define _POOLLOCK atomic_int lock;
+//the lock is a spin lock, a lock-free list would suffer from the ABA problem
+#define _POOLATOMIC(NAME,T)\
+	static inline T *CONC(NAME,_alloc_atomic)(void) {\
+		while (atomic_exchange_explicit(&CONC(NAME,_pool).lock, 1, memory_order_acquire));\
+		T *p = CONC(NAME,_alloc)();\
+		atomic_store_explicit(&CONC(NAME,_pool).lock, 0, memory_order_release);\
+		return p;\
+	}\
+	static inline void CONC(NAME,_free_atomic)(T *p) {\
+		while (atomic_exchange_explicit(&CONC(NAME,_pool).lock, 1, memory_order_acquire));\
+		CONC(NAME,_free)(p);\
+		atomic_store_explicit(&CONC(NAME,_pool).lock, 0, memory_order_release);\
+	}
+#else
+#define _POOLLOCK
+#define _POOLATOMIC(NAME,T)
+#endif
+
+#if CODEGEN_ATOMICS
+#ifndef CODEGEN_CACHELINE
+#define CODEGEN_CACHELINE 64
+#endif
+/** Declares the ring buffer struct NAME for one producer and one consumer thread with CAPACITY elements of
+ * type T, a power of two so that the indices are masked instead of divided. The indices of both sides live
+ * in their own cache lines with a cached copy of the other side, so they only touch the line of the other
+ * side when the queue looks full or empty. A zero-initialized struct NAME is an empty queue.
+ *   SPSC_QUEUE(evq,struct event,256)
+ *   static struct evq q;
+ *   evq_push(&q,ev);	//producer, 0 if full
+ *   evq_pop(&q,&ev);	//consumer, 0 if empty
+ * evq_push_n and evq_pop_n move up to n elements with a single release store and return how many. */
+#define SPSC_QUEUE(NAME,T,CAPACITY)\
+	struct NAME {\
+		_Alignas(CODEGEN_CACHELINE) atomic_size_t tail; size_t head_cache;\
+		_Alignas(CODEGEN_CACHELINE) atomic_size_t head; size_t tail_cache;\
+		_Alignas(CODEGEN_CACHELINE) T buf[CAPACITY];\
+	};\
+	static inline size_t CONC(NAME,_push_n)(struct NAME *q, const T *v, size_t n) {\
+		size_t t = atomic_load_explicit(&q->tail, memory_order_relaxed);\
+		if ((CAPACITY) - (t - q->head_cache) < n)\
+			q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);\
+		if (n > (CAPACITY) - (t - q->head_cache))\
+			n = (CAPACITY) - (t - q->head_cache);\
+		for (size_t i = 0; i < n; i++)\
+			q->buf[(t + i) & ((CAPACITY) - 1)] = v[i];\
+		atomic_store_explicit(&q->tail, t + n, memory_order_release);\
+		return n;\
+	}\
+	static inline size_t CONC(NAME,_pop_n)(struct NAME *q, T *v, size_t n) {\
+		size_t h = atomic_load_explicit(&q->head, memory_order_relaxed);\
+		if (q->tail_cache - h < n)\
+			q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);\
+		if (n > q->tail_cache - h)\
+			n = q->tail_cache - h;\
+		for (size_t i = 0; i < n; i++)\
+			v[i] = q->buf[(h + i) & ((CAPACITY) - 1)];\
+		atomic_store_explicit(&q->head, h + n, memory_order_release);\
+		return n;\
+	}\
+	static inline int CONC(NAME,_push)(struct NAME *q, T v) { return CONC(NAME,_push_n)(q, &v, 1); }\
+	static inline int CONC(NAME,_pop)(struct NAME *q, T *v) { return CONC(NAME,_pop_n)(q, v, 1); }\
+	FAIL_IFNOT((CAPACITY) > 0 && !((CAPACITY) & ((CAPACITY) - 1)), the capacity of NAME is no power of two)
+#endif
+
+/** Declares the sorted constant KEYS (at most LOOPMAX) as a search tree in Eytzinger (breadth-first) order:
+ * the children of the node k are 2k and 2k+1, so the first levels which every search visits share the
+ * same cache lines. The tree always has 31 nodes, the missing keys are padded with the last key, so the
+ * lookup is five fixed steps of a compare and an add without branches.
+ *   STATIC_SEARCH(prime,2,3,5,7,11,13)
+ *   prime_find(7)	//3, the index in the key list, -1 if not found
+ * STATIC_SEARCH_T declares the keys with another integer type than int. Every neighbouring pair of keys is
+ * compared at compile-time, unsorted or duplicate keys fail with a static assertion. */
+#define STATIC_SEARCH(NAME,...) STATIC_SEARCH_T(NAME,int,__VA_ARGS__)
+#define STATIC_SEARCH_T(NAME,T,...)\
+	static const T CONC(NAME,_eytz)[32] = {TAKE(__VA_ARGS__) _EYTZINGER31(F_SEARCHKEY,(TAKE_LAST(__VA_ARGS__),__VA_ARGS__))};\
+	enum { CONC(NAME,_COUNT) = ARGNUM(__VA_ARGS__) };\
+	static inline int CONC(NAME,_find)(T x) {\
+		unsigned k = 1, d;\
+		while (k < 32)\
+			k = 2 * k + (CONC(NAME,_eytz)[k] < x);\
+		k >>= __builtin_ffs(~k);\
+		if (!k || CONC(NAME,_eytz)[k] != x)\
+			return -1;\
+		d = 8 * sizeof(unsigned) - 1 - __builtin_clz(k);	/* the rank follows from the level d */\
+		k = ((2 * (k - (1u << d)) + 1) << (4 - d)) - 1;\
+		return k < CONC(NAME,_COUNT) ? (int)k : CONC(NAME,_COUNT) - 1;\
+	}\
+	FAIL_IFNOT(_SEARCHSORTED(__VA_ARGS__), the keys of NAME are not sorted strictly ascending)
+//compares every neighbouring pair, ISSORTED stops after LOOPLIMIT keys
+#define _SEARCHSORTED(...) (1 _REPEATN(ARGNUM(__VA_ARGS__),F_SEARCHSORTED,_SEARCHSORTEDSTEP,(__VA_ARGS__),))
+#define F_SEARCHSORTED(_,ARGS) _SEARCHPAIR(_TAKE0 ARGS,_SEARCHNEXT(_DROP0 ARGS,))
+#define _SEARCHNEXT(...) _TAKE0(__VA_ARGS__)
+#define _SEARCHPAIR(...) _SEARCHPAIR0(__VA_ARGS__)
+#define _SEARCHPAIR0(A,B) IF(B,&& (A) < (B))
+#define _SEARCHSORTEDSTEP(ARGS) (_DROP0 ARGS)
+//applies FUNC to the in-order ranks of the perfect tree with 31 nodes in breadth-first order
+#define _EYTZINGER31(FUNC,ARGS) FUNC(15,ARGS) FUNC(7,ARGS) FUNC(23,ARGS)\
+	FUNC(3,ARGS) FUNC(11,ARGS) FUNC(19,ARGS) FUNC(27,ARGS)\
+	FUNC(1,ARGS) FUNC(5,ARGS) FUNC(9,ARGS) FUNC(13,ARGS) FUNC(17,ARGS) FUNC(21,ARGS) FUNC(25,ARGS) FUNC(29,ARGS)\
+	FUNC(0,ARGS) FUNC(2,ARGS) FUNC(4,ARGS) FUNC(6,ARGS) FUNC(8,ARGS) FUNC(10,ARGS) FUNC(12,ARGS) FUNC(14,ARGS)\
+	FUNC(16,ARGS) FUNC(18,ARGS) FUNC(20,ARGS) FUNC(22,ARGS) FUNC(24,ARGS) FUNC(26,ARGS) FUNC(28,ARGS) FUNC(30,ARGS)
+#define F_SEARCHKEY(RANK,ARGS) , _SEARCHKEY(RANK,_GENI ARGS)
+#define _SEARCHKEY(RANK,...) _SEARCHKEY0(RANK,__VA_ARGS__)
+#define _SEARCHKEY0(RANK,PAD,...) TRY(TAKE(DROPN(RANK,__VA_ARGS__)),PAD)
+
+/** Registration tables without constructor functions: REGISTER puts each entry into the linker section
+ * table_NAME, the linker collects the entries of all translation units into one contiguous array, so
+ * no code runs at startup and a lookup is a scan over the array. The linker defines the bounds
+ * __start_table_NAME and __stop_table_NAME (GNU ld, gold and lld for sections named like C identifiers).
+ *   TABLE_DECLARE(drivers,struct driver)	//in a header for all translation units
+ *   REGISTER(drivers,{"uart",uart_init});	//at file scope in any translation unit
+ *   TABLE_FINALIZE(drivers)				//where the table is read
+ *   for (const struct driver *d = drivers_begin(); d != drivers_end(); d++) ...
+ * The order of the entries is not defined. The entries are static, __COUNTER__ gives them unique names.
+ * The linker only defines the bounds of a section with entries, so they are declared weak: a table without
+ * any REGISTER links as an empty one with both bounds 0 instead of failing on undefined symbols. */
+#define TABLE_DECLARE(NAME,T)\
+	typedef T CONC(NAME,_t);\
+	extern const CONC(NAME,_t) CONC(__start_table_,NAME)[] __attribute__((weak)), CONC(__stop_table_,NAME)[] __attribute__((weak))
+//the user defined alignment prevents padding between the entries because GCC won't increase it anymore
+#define REGISTER(NAME,...) static const CONC(NAME,_t) CONC(CONC(NAME,_entry),__COUNTER__)\
+	__attribute__((used, section(STRING(CONC(table_,NAME))), aligned(_Alignof(CONC(NAME,_t))))) = __VA_ARGS__
+#define TABLE_FINALIZE(NAME)\
+	static inline const CONC(NAME,_t) *CONC(NAME,_begin)(void) { return CONC(__start_table_,NAME); }\
+	static inline const CONC(NAME,_t) *CONC(NAME,_end)(void) { return CONC(__stop_table_,NAME); }\
+	static inline size_t CONC(NAME,_count)(void) { return (size_t)(CONC(__stop_table_,NAME) - CONC(__start_table_,NAME)); }
+
+/** Declares struct NAME from the (type,field) pairs together with a serialization in a fixed little endian
+ * wire layout (CODEC_BE for big endian) without padding:
+ *   CODEC(sample,(uint32_t,time),(int16_t,value),(uint8_t,flags))
+ * gives the offsets sample_OFF_time, sample_OFF_value and sample_OFF_flags, the size sample_WIRE_SIZE (7)
+ * and sample_pack(out,v), sample_unpack(v,in) for one struct and sample_pack_n and sample_unpack_n for
+ * arrays. The fields have to be scalars. With the wire order of the host every field is a memcpy at a
+ * constant offset, which the compiler merges into wide moves. */
+#define CODEC(NAME,...) _CODEC(NAME,0,__VA_ARGS__)
+#define CODEC_BE(NAME,...) _CODEC(NAME,1,__VA_ARGS__)
+#define CODEC_HOST_BE (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define _CODEC(NAME,BE,...)\
+	struct NAME {_MAPN(ARGNUM(__VA_ARGS__),F_CODECMEMBER,_MAPI0,,__VA_ARGS__)};\
+	enum {_REPEATN(ARGNUM(__VA_ARGS__),F_CODECOFF,_CODECOFFSTEP,(NAME,0,__VA_ARGS__),)\
+		CONC(NAME,_WIRE_SIZE) = 0 _MAPN(ARGNUM(__VA_ARGS__),F_CODECSIZE,_MAPI0,,__VA_ARGS__)};\
+	static inline void CONC(NAME,_pack)(unsigned char *out, const struct NAME *v) {\
+		_MAPN(ARGNUM(__VA_ARGS__),F_CODECPACK,_MAPI0,(NAME,BE),__VA_ARGS__)\
+	}\
+	static inline void CONC(NAME,_unpack)(struct NAME *v, const unsigned char *in) {\
+		_MAPN(ARGNUM(__VA_ARGS__),F_CODECUNPACK,_MAPI0,(NAME,BE),__VA_ARGS__)\
+	}\
+	static inline void CONC(NAME,_pack_n)(unsigned char *out, const struct NAME *v, size_t n) {\
+		for (size_t i = 0; i < n; i++)\
+			CONC(NAME,_pack)(out + i * CONC(NAME,_WIRE_SIZE), v + i);\
+	}\
+	static inline void CONC(NAME,_unpack_n)(struct NAME *v, const unsigned char *in, size_t n) {\
+		for (size_t i = 0; i < n; i++)\
+			CONC(NAME,_unpack)(v + i, in + i * CONC(NAME,_WIRE_SIZE));\
+	}
+#define F_CODECMEMBER(A,_) _CODECMEMBER A
+#define _CODECMEMBER(T,F) T F;
+#define F_CODECSIZE(A,_) _CODECSIZE A
+#define _CODECSIZE(T,F) + sizeof(T)
+//every offset is the previous one plus the size of the previous type
+#define F_CODECOFF(_,ARGS) _CODECOFF ARGS
+#define _CODECOFF(NAME,OFF,A,...) _CODECOFF0(NAME,OFF,_GENI A)
+#define _CODECOFF0(...) _CODECOFF1(__VA_ARGS__)
+#define _CODECOFF1(NAME,OFF,T,F) CONC(NAME,_OFF_ ## F) = OFF,
+#define _CODECOFFSTEP(ARGS) _CODECOFFSTEP0 ARGS
+#define _CODECOFFSTEP0(NAME,OFF,A,...) (NAME,_CODECOFFNEXT(NAME,_GENI A),__VA_ARGS__)
+#define _CODECOFFNEXT(...) _CODECOFFNEXT0(__VA_ARGS__)
+#define _CODECOFFNEXT0(NAME,T,F) CONC(NAME,_OFF_ ## F) + sizeof(T)
+#define F_CODECPACK(A,ARGS) _CODECPACK(_GENI ARGS,_GENI A)
+#define _CODECPACK(...) _CODECPACK0(__VA_ARGS__)
+#define _CODECPACK0(NAME,BE,T,F) _codec_copy(out + CONC(NAME,_OFF_ ## F), &v->F, sizeof(T), BE != CODEC_HOST_BE);
+#define F_CODECUNPACK(A,ARGS) _CODECUNPACK(_GENI ARGS,_GENI A)
+#define _CODECUNPACK(...) _CODECUNPACK0(__VA_ARGS__)
+#define _CODECUNPACK0(NAME,BE,T,F) _codec_copy(&v->F, in + CONC(NAME,_OFF_ ## F), sizeof(T), BE != CODEC_HOST_BE);
+static inline void _codec_copy(void *dst, const void *src, size_t n, int swap) {
+	if (!swap)
+		memcpy(dst, src, n);
+	else
+		for (size_t i = 0; i < n; i++)
+			((unsigned char *)dst)[i] = ((const unsigned char *)src)[n - 1 - i];
+}
+
+/** Interns the names of the IDs into one string blob instead of an array of pointers:
+ *   STRING_TABLE(color,red,green,blue)
+ * gives enum color_id {color_red, color_green, color_blue, color_COUNT}, the blob color_blob
+ * ("red\0green\0blue\0"), the offsets color_offsets and color_str(id) with the name of the ID.
+ * The offsets are sums of the literal sizes, so the table needs no relocations and fits into few cache lines. */
+#define STRING_TABLE(NAME,...)\
+	enum CONC(NAME,_id) {_MAPN(ARGNUM(__VA_ARGS__),F_STRTABLEID,_MAPI0,NAME,__VA_ARGS__) CONC(NAME,_COUNT)};\
+	enum {_REPEATN(ARGNUM(__VA_ARGS__),F_STRTABLEOFF,_STRTABLEOFFSTEP,(NAME,0,__VA_ARGS__),)\
+		CONC(NAME,_BLOB_SIZE) = 0 _MAPN(ARGNUM(__VA_ARGS__),F_STRTABLESIZE,_MAPI0,,__VA_ARGS__)};\
+	FAIL_IF(CONC(NAME,_BLOB_SIZE) > UINT16_MAX, string table too large for uint16_t offsets);\
+	static const char CONC(NAME,_blob)[] = _MAPN(ARGNUM(__VA_ARGS__),F_STRTABLESTR,_MAPI0,,__VA_ARGS__);\
+	static const uint16_t CONC(NAME,_offsets)[] = {_MAPN(ARGNUM(__VA_ARGS__),F_STRTABLEOFFSET,_MAPI0,NAME,__VA_ARGS__)};\
+	static inline const char *CONC(NAME,_str)(enum CONC(NAME,_id) id) {\
+		return (unsigned)id < CONC(NAME,_COUNT) ? CONC(NAME,_blob) + CONC(NAME,_offsets)[id] : "";\
+	}
+#define F_STRTABLEID(A,NAME) CONC(NAME,_ ## A),
+#define F_STRTABLESIZE(A,_) + sizeof(STRING(A))
+//every name ends with its own NUL, the implicit one of the literal is a spare byte of the blob
+#define F_STRTABLESTR(A,_) STRING(A) "\0"
+#define F_STRTABLEOFFSET(A,NAME) CONC(NAME,_OFF_ ## A),
+//every offset is the previous one plus the size of the previous name with its NUL
+#define F_STRTABLEOFF(_,ARGS) _STRTABLEOFF ARGS
+#define _STRTABLEOFF(NAME,OFF,A,...) CONC(NAME,_OFF_ ## A) = OFF,
+#define _STRTABLEOFFSTEP(ARGS) _STRTABLEOFFSTEP0 ARGS
+#define _STRTABLEOFFSTEP0(NAME,OFF,A,...) (NAME,CONC(NAME,_OFF_ ## A) + sizeof(STRING(A)),__VA_ARGS__)
+
+#endif
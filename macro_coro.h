@@ -0,0 +1,67 @@
+/** Stackless coroutines with Preprocessor */
+//protothreads for event loops and boards without threads, a context switch stores one label offset
+
+#ifndef MACRO_CORO_H
+#define MACRO_CORO_H
+#include "macro_codegen.h"
+
+/** Declares the state struct NAME with the parenthesized parameter list as persistent members and
+ * the step function int NAME(void *self), which is followed by the body with the coroutine:
+ *   CORO(blink,(int led, int i)) {
+ *   	CORO_BEGIN();
+ *   	for (self->i = 0; self->i < 3; self->i++) {
+ *   		toggle(self->led);
+ *   		CORO_YIELD();
+ *   	}
+ *   	CORO_AWAIT(button_pressed());
+ *   	CORO_END();
+ *   }
+ *   struct blink b = {.led = 2};	//a zeroed state starts at CORO_BEGIN
+ *   while (blink(&b) == CORO_WAITING) ...
+ * Local variables of the body lose their values at CORO_YIELD and CORO_AWAIT, keep them in the members
+ * of self. The labels are named with __LINE__ (NAME), so only one of the macros is allowed per line.
+ * It resumes with a computed goto (GCC) to the offset of the label from CORO_BEGIN, so switch statements
+ * in the body are no problem. The offsets would differ in a clone of the body, so it is never inlined or
+ * cloned, the cheap step function NAME around it may be. */
+#define CORO(NAME,...)\
+	struct NAME { int _resume; PARAMS_TO_MEMBERS(__VA_ARGS__) };\
+	static int CONC(NAME,_body)(struct NAME *self) __attribute__((_CORO_NOCLONE));\
+	static inline int NAME(void *self) { return CONC(NAME,_body)(self); }\
+	static int CONC(NAME,_body)(struct NAME *self)
+//clang has no noclone attribute
+#ifdef __clang__
+#define _CORO_NOCLONE noinline
+#else
+#define _CORO_NOCLONE noinline, noclone
+#endif
+#define CORO_DONE 0
+#define CORO_WAITING 1
+#define _CORO_OFFSET(LABEL) (int)(&&LABEL - &&_coro_begin)
+//restarts the coroutine from the beginning at the next step
+#define CORO_RESET(SELF) MACRO((SELF)->_resume = 0;)
+#define CORO_BEGIN() MACRO(goto *(&&_coro_begin + self->_resume); _coro_begin:;)
+#define CORO_YIELD() MACRO(self->_resume = _CORO_OFFSET(NAME(yield)); return CORO_WAITING; NAME(yield):;)
+//checks COND on every step until it is true
+#define CORO_AWAIT(COND) MACRO(self->_resume = _CORO_OFFSET(NAME(await)); NAME(await): if (!(COND)) return CORO_WAITING;)
+//every further step returns CORO_DONE
+#define CORO_END() MACRO(self->_resume = _CORO_OFFSET(NAME(end)); NAME(end): return CORO_DONE;)
+
+/** Round robin scheduler for coroutines of different types:
+ *   struct coro_task tasks[] = {{blink,&b},{poll,&p}};
+ *   coro_schedule(tasks,2);
+ * It steps every task in turn until all of them are done and clears step of the finished tasks. */
+struct coro_task { int (*step)(void *self); void *self; };
+static inline void coro_schedule(struct coro_task *tasks, size_t n) {
+	for (size_t running = n; running; ) {
+		running = 0;
+		for (size_t i = 0; i < n; i++)
+			if (tasks[i].step) {
+				if (tasks[i].step(tasks[i].self) == CORO_DONE)
+					tasks[i].step = NULL;
+				else
+					running++;
+			}
+	}
+}
+
+#endif
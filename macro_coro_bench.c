@@ -0,0 +1,80 @@
+/** Benchmark of CORO context switches against pthread context switches */
+//gcc -O2 -pthread macro_coro_bench.c && ./a.out [switches]
+//two coroutines hand over to each other through coro_schedule, two threads through a mutex and a condition
+//variable, every handover is one context switch
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_coro.h"
+
+static long switches = 10000000;
+static volatile long ball;
+
+CORO(ping,(long n)) {
+	CORO_BEGIN();
+	for (self->n = 0; self->n < switches / 2; self->n++) {
+		ball++;
+		CORO_YIELD();
+	}
+	CORO_END();
+}
+CORO(pong,(long n)) {
+	CORO_BEGIN();
+	for (self->n = 0; self->n < switches / 2; self->n++) {
+		ball--;
+		CORO_YIELD();
+	}
+	CORO_END();
+}
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t turn = PTHREAD_COND_INITIALIZER;
+static long owner;
+static long thread_switches;
+
+static void *player(void *arg) {
+	long me = (long)arg;
+	pthread_mutex_lock(&lock);
+	for (long i = 0; i < thread_switches / 2; i++) {
+		while (owner != me)
+			pthread_cond_wait(&turn, &lock);
+		owner = !me;
+		pthread_cond_signal(&turn);
+	}
+	pthread_mutex_unlock(&lock);
+	return NULL;
+}
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+	if (argc > 1)
+		switches = strtol(argv[1], NULL, 10);
+	//the threads are a thousand times slower, fewer switches give the same precision
+	thread_switches = switches / 100 > 2 ? switches / 100 : 2;
+	struct ping a = {0};
+	struct pong b = {0};
+	struct coro_task tasks[] = {{ping,&a},{pong,&b}};
+	double start = seconds();
+	coro_schedule(tasks, 2);
+	double coro = (seconds() - start) / switches;
+	pthread_t threads[2];
+	start = seconds();
+	for (long t = 0; t < 2; t++)
+		if (pthread_create(&threads[t], NULL, player, (void *)t)) {
+			perror("pthread_create");
+			return 2;
+		}
+	for (long t = 0; t < 2; t++)
+		pthread_join(threads[t], NULL);
+	double thread = (seconds() - start) / thread_switches;
+	printf("coroutine switch %.1f ns (%zu bytes of state), pthread switch %.1f ns, %.0fx\n",
+		coro * 1e9, sizeof a, thread * 1e9, thread / coro);
+	return ball != 0;
+}
@@ -0,0 +1,61 @@
+/** Benchmark of the threaded DISPATCH_TABLE against its switch fallback */
+//gcc -O2 macro_dispatch_bench.c && ./a.out [rounds]
+//gcc -O2 -DDISPATCH_SWITCH macro_dispatch_bench.c && ./a.out [rounds]
+//a random program of accumulator instructions keeps the branch predictor busy, both builds print the same result
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+#define PROGRAM 4096
+DISPATCH_ENUM(op,(inc,dec,dbl,half,addi,xori,neg,loop,halt));
+static unsigned char code[PROGRAM + 3];
+
+static unsigned run(const unsigned char *start, long rounds) {
+	DISPATCH_TABLE(op,(inc,dec,dbl,half,addi,xori,neg,loop,halt))
+	#define NEXT() DISPATCH_NEXT(op,*pc++)
+	const unsigned char *pc = start;
+	unsigned acc = 0;
+	DISPATCH_BEGIN(op,*pc++)
+	DISPATCH_CASE(op,inc) acc++; NEXT();
+	DISPATCH_CASE(op,dec) acc--; NEXT();
+	DISPATCH_CASE(op,dbl) acc *= 2; NEXT();
+	DISPATCH_CASE(op,half) acc /= 2; NEXT();
+	DISPATCH_CASE(op,addi) acc += *pc++; NEXT();
+	DISPATCH_CASE(op,xori) acc ^= *pc++; NEXT();
+	DISPATCH_CASE(op,neg) acc = -acc; NEXT();
+	DISPATCH_CASE(op,loop) if (--rounds > 0) pc = start; NEXT();
+	DISPATCH_CASE(op,halt) return acc;
+	DISPATCH_END(op)
+	#undef NEXT
+	return acc;
+}
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+	long rounds = argc > 1 ? strtol(argv[1], NULL, 10) : 5000, ops = 0;
+	size_t n = 0;
+	srand(1);
+	while (n < PROGRAM) {
+		unsigned char o = rand() % op_loop;
+		code[n++] = o;
+		if (o == op_addi || o == op_xori)
+			code[n++] = rand() % 256;
+		ops++;
+	}
+	code[n] = op_loop;
+	code[n + 1] = op_halt;
+	ops++;
+	double start = seconds();
+	unsigned acc = run(code, rounds);
+	double elapsed = seconds() - start;
+	printf("%s dispatch: %.2f ns per instruction, result %u\n", DISPATCH_THREADED ? "threaded" : "switch",
+		elapsed / (ops * rounds) * 1e9, acc);
+	return 0;
+}
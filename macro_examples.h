@@ -1,4 +1,5 @@
 #include "macro_api.h"
+#include "macro_codegen.h"
 
 //test namespace recognition
 #define _NAME_hello NAME_NOLAST
@@ -14,6 +15,53 @@
 #define _NAMEA_dieter
 #define _NAMEB_achim
 #define _NAMEC_jojo
+NAMESPACE_ASSERT(_NAMEA, herbert, dieter);	//one paste per name, no WHILE loop
+
+//test feature resolution
+#define _FEATURE_NET FEATURES_DECLARE(0,(SOCKET,BUFFERS),(SERIAL))
+#define _FEATURE_SOCKET FEATURES_DECLARE(1,(BUFFERS),())
+#define _FEATURE_BUFFERS FEATURES_DECLARE(2,(),())
+#define _FEATURE_SERIAL FEATURES_DECLARE(3,(BUFFERS),(NET))
+#define FEATURES_ENABLED NET
+#if FEATURES_CONFLICT(FEATURES_ENABLED)
+#error "conflicting features"
+#endif
+FAIL_IFNOT(FEATURE(BUFFERS) && !FEATURE(SERIAL));	//required by SOCKET, required by NET
+//#if FEATURE(SOCKETS)	//fails: FEATURE_NOT_DECLARED_SOCKETS
+
+#define SUM_KERNEL(FNAME,T) T FNAME(const T *x, int n) { T s = 0; while(n--) s += *x++; return s; }
+GENERIC_KERNEL(sum,(int,float,double),SUM_KERNEL)
+#define sum(X,...) GENERIC_DISPATCH(sum,(int,float,double),*(X))(X,__VA_ARGS__)
+
+FLAGSET(opt,verbose,dry,force);	//opt_verbose = 1, opt_dry = 2, opt_force = 4, opt_ALL = 7
+POOL(numpool,double,16);
+SPSC_QUEUE(intq,int,8);
+STATIC_SEARCH(prime,2,3,5,7,11,13,17,19,23,29);
+//STATIC_SEARCH(unsorted,2,3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,61,59);	//fails: the keys of unsorted are not sorted strictly ascending
+TABLE_DECLARE(commands,const char *);
+REGISTER(commands,"help");	//from any translation unit
+REGISTER(commands,"quit");
+TABLE_FINALIZE(commands)
+TABLE_DECLARE(plugins,const char *);	//without REGISTER, plugins_count() is 0
+TABLE_FINALIZE(plugins)
+CODEC(sample,(uint32_t,time),(int16_t,value),(uint8_t,flags))	//sample_WIRE_SIZE is 7, sizeof(struct sample) 8
+STRING_TABLE(color,red,green,blue)	//"red\0green\0blue\0" with the offsets 0, 4, 10
+
+DISPATCH_ENUM(op,(push,add,halt));
+static inline int interpret(const unsigned char *pc) {
+	DISPATCH_TABLE(op,(push,add,halt))
+	#define NEXT() DISPATCH_NEXT(op,*pc++)
+	int stack[8], *sp = stack;
+	DISPATCH_BEGIN(op,*pc++)
+	DISPATCH_CASE(op,push) *sp++ = *pc++; NEXT();
+	DISPATCH_CASE(op,add) sp--; sp[-1] += *sp; NEXT();
+	DISPATCH_CASE(op,halt) return sp[-1];
+	DISPATCH_END(op)
+	#undef NEXT
+	return 0;
+}
+//Taylor series of e^x, Estrin's scheme evaluates the pairs in parallel, POLY_HORNER in sequence
+static inline double exp6(double x) { return POLY_ESTRIN(x,1,1,1/2.,1/6.,1/24.,1/120.,1/720.); }
 
 int x = COUNT_N(REDUCE2(ADD,PP0,PP1,PP2,PP3,PP4,PP5)),		//very cheap calculation,
 y = REDUCE(DEC_ADD,0,1,2,3,4,5),	//expensive calculation
@@ -38,21 +86,43 @@ static inline int test(int arg) {
 		RROTATE(UNARY_ARGC(,2,3,,4),1,2,3,4,5,6,7,8),
 		REVERSE(0x5,0x6,0x7,0x8,0x9,0xA),
 		WHILE(I,I,a,b,c)    //condition is always true, thus expansion is blank
-		//this works but too high LOOPLIMIT leads to multiple seconds of Atollic IDE startup lag
-		FLATTEN((),(2),(3,4),((1,2,(3),4),5)),	//this example takes about 15 loop cycles and exits in 16th. LOOPLIMIT must be >= 16
+		FLATTEN((),(2),(3,4),((1,2,(3),4),5)),	//this example takes 3 loop cycles, one per nesting level
+		FLATTEN_DEPTH(1,(1,(2)),3),	//removes one level: 1, (2), 3
 		ENUMBIN(4)
 	};
 
 	int cart[] = {100 CARTESIAN(,F_PREPENDNUM,,(DECIMAL),DECIMAL)};
+	int window[] = {CARTWINDOW(CONC,(7,4),8,(DECIMAL),(1,2,3,4,5,6,7,8,9))};	//tuples 47 to 54 of 90: 25, 15, 5, 96 ...
+	int aos[] = {FLATTEN(ZIP_N(,(1,2,3),(10,20,30),(100,200,300)))};	//interleaves the lists: 1, 10, 100, 2, 20 ...
 	int d1000[] = {CONCNUMS((DECIMAL),CONCNUMS((DECIMAL),DECIMAL))};	//this generates comma-separated 999 down to 1000 - LIMIT*10
 	int h256[] = {CONCNUMS((HEXADEC),CONCNUMS((HEXADEC),0x))};	//generates comma-separated 0xFF down to 0x0
 
+	float halves[] = {0.5f, 1.5f};
+	aa = sum(window,8) + (int)sum(halves,2);	//calls sum_int and sum_float
+	halves[0] = exp6(halves[1]);
+	opt_t options = opt_set(opt_verbose,opt_dry|opt_force);
+	if (opt_test(options,opt_dry))	//a single AND
+		options = opt_clear(options,opt_ALL);
+	double *num = numpool_alloc();
+	if (num)
+		numpool_free(num);
+	static struct intq queue;
+	intq_push(&queue,x);
+	intq_pop(&queue,&aa);
+	aa = prime_find(aa);	//index of aa in the primes or -1
+	aa += (int)commands_count();
+	struct sample smp = {1, -2, 3};
+	unsigned char wire[sample_WIRE_SIZE];
+	sample_pack(wire,&smp);
+	sample_unpack(&smp,wire);
+	aa += (int)strlen(color_str(color_green));
 	int dec[] = {FILTER(F_ISDEC,HEXADEC)};
 	int hex[] = {RCARTCAT((FILTER_OUT(F_ISDEC,HEXADEC)),0x)};	//try to put smaller list on the right, always
 
 	int DEFINE(0, a, b, c, d, e, f);
 	ASSIGN(DROPN(2, b, c, d, e), RMAP(F_DIV,20,57,111,60,12,2));
 	ASSIGN(TAKEN(DEC_DIV(17,5), a, b, c, d, e, f), LMAP(F_MUL, 4, 2, e));
+	f = TREE_REDUCE_OP(|, a, b, c, d, e, dec[3], hex[2]);	//((a | b) | (c | d)) | ... instead of a chain
 //	DIV_DBG(TO_UNARY(17),PP5);		//hihi, I forgot to use _DIVI for the multi-element COND argument
 	if (ISSORTED(<,SLICE(2,7,30)))
 		x = a;
@@ -0,0 +1,68 @@
+/** Benchmark of GENERIC_KERNEL specializations against a void pointer kernel with an element type tag */
+//gcc -O2 macro_generic_bench.c && ./a.out [passes]
+//y += a * x over int, float and double arrays, the specializations vectorize, the void pointer kernel
+//converts every element through a switch on the type
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+#define N 4096
+#define AXPY(FNAME,T) void FNAME(T *restrict y, const T *restrict x, T a, int n) { for (int i = 0; i < n; i++) y[i] += a * x[i]; }
+GENERIC_KERNEL(axpy,(int,float,double),AXPY)
+#define axpy(Y,...) GENERIC_DISPATCH(axpy,(int,float,double),*(Y))(Y,__VA_ARGS__)
+
+enum elem { ELEM_INT, ELEM_FLOAT, ELEM_DOUBLE };
+//the kernel of a runtime type, kept out of line like in a library
+__attribute__((noinline)) static void axpy_any(void *y, const void *x, double a, int n, size_t size, enum elem type) {
+	for (int i = 0; i < n; i++) {
+		char *py = (char *)y + i * size;
+		const char *px = (const char *)x + i * size;
+		switch (type) {
+		case ELEM_INT: *(int *)py += (int)a * *(const int *)px; break;
+		case ELEM_FLOAT: *(float *)py += (float)a * *(const float *)px; break;
+		case ELEM_DOUBLE: *(double *)py += a * *(const double *)px; break;
+		}
+	}
+}
+
+static int xi[N], yi[N], zi[N];
+static float xf[N], yf[N], zf[N];
+static double xd[N], yd[N], zd[N];
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+//nanoseconds per element of the passes over the array
+#define TIME(PASSES,...) ({\
+	double start = seconds();\
+	for (long k = 0; k < (PASSES); k++) {\
+		__VA_ARGS__;\
+		__asm__ volatile("" ::: "memory");\
+	}\
+	(seconds() - start) / (PASSES) / N * 1e9;\
+	})
+
+int main(int argc, char **argv) {
+	long passes = argc > 1 ? strtol(argv[1], NULL, 10) : 20000;
+	for (int i = 0; i < N; i++) {
+		xi[i] = i % 7;
+		xf[i] = xd[i] = i % 7 * 0.25;
+	}
+	printf("int:    GENERIC_KERNEL %.3f ns, void * %.3f ns\n",
+		TIME(passes, axpy(yi, xi, 3, N)), TIME(passes, axpy_any(zi, xi, 3, N, sizeof *zi, ELEM_INT)));
+	printf("float:  GENERIC_KERNEL %.3f ns, void * %.3f ns\n",
+		TIME(passes, axpy(yf, xf, 0.5f, N)), TIME(passes, axpy_any(zf, xf, 0.5, N, sizeof *zf, ELEM_FLOAT)));
+	printf("double: GENERIC_KERNEL %.3f ns, void * %.3f ns\n",
+		TIME(passes, axpy(yd, xd, 0.5, N)), TIME(passes, axpy_any(zd, xd, 0.5, N, sizeof *zd, ELEM_DOUBLE)));
+	//both kernels ran the same passes, so the results have to match
+	for (int i = 0; i < N; i++)
+		if (yi[i] != zi[i] || yf[i] != zf[i] || yd[i] != zd[i]) {
+			fprintf(stderr, "element %d differs\n", i);
+			return 1;
+		}
+	return 0;
+}
@@ -0,0 +1,317 @@
+/** File iteration with Preprocessor */
+//includes a template file once per index, so the cost grows linearly without any loop limit
+
+/* Define the template file and the range before including this file:
+ *   #define ITERATE_FILE "vector_ops.h"
+ *   #define ITERATE_FIRST 1		//optional, default 0
+ *   #define ITERATE_LAST 200		//at most 999
+ *   #include "macro_iterate.h"
+ * vector_ops.h is included for every ITERATION from ITERATE_FIRST to ITERATE_LAST. ITERATION is a decimal
+ * literal, so it can be pasted like CONC(add_,ITERATION) and compared in #if directives. It is put together
+ * from three digits which are set by the unrolled #include chains below, no macro expansion grows with the
+ * number of iterations. All the macros are undefined afterwards, so the next iteration can start.
+ * The template file must not include this file itself and must not have an include guard. */
+#ifndef _ITER_DEPTH
+#if !defined(ITERATE_FILE) || !defined(ITERATE_LAST)
+#error "define ITERATE_FILE and ITERATE_LAST before including macro_iterate.h"
+#endif
+#ifndef ITERATE_FIRST
+#define ITERATE_FIRST 0
+#endif
+#if ITERATE_FIRST < 0 || ITERATE_LAST > 999
+#error "macro_iterate.h only counts from 0 to 999"
+#endif
+#include "macro_programming.h"
+//leading zero digits are blank, otherwise the literal would be octal
+#define ITERATION CONC(CONC(_ITER_P2,_ITER_P1),_ITER_D0)
+#define _ITER_DEPTH 2
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#undef _ITER_D2
+#undef _ITER_D1
+#undef _ITER_D0
+#undef _ITER_P2
+#undef _ITER_P1
+#undef ITERATION
+#undef ITERATE_FILE
+#undef ITERATE_FIRST
+#undef ITERATE_LAST
+
+#elif _ITER_DEPTH == 2
+#if ITERATE_FIRST <= 99 && ITERATE_LAST >= 0
+#undef _ITER_D2
+#define _ITER_D2 0
+#undef _ITER_P2
+#define _ITER_P2
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 199 && ITERATE_LAST >= 100
+#undef _ITER_D2
+#define _ITER_D2 1
+#undef _ITER_P2
+#define _ITER_P2 1
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 299 && ITERATE_LAST >= 200
+#undef _ITER_D2
+#define _ITER_D2 2
+#undef _ITER_P2
+#define _ITER_P2 2
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 399 && ITERATE_LAST >= 300
+#undef _ITER_D2
+#define _ITER_D2 3
+#undef _ITER_P2
+#define _ITER_P2 3
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 499 && ITERATE_LAST >= 400
+#undef _ITER_D2
+#define _ITER_D2 4
+#undef _ITER_P2
+#define _ITER_P2 4
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 599 && ITERATE_LAST >= 500
+#undef _ITER_D2
+#define _ITER_D2 5
+#undef _ITER_P2
+#define _ITER_P2 5
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 699 && ITERATE_LAST >= 600
+#undef _ITER_D2
+#define _ITER_D2 6
+#undef _ITER_P2
+#define _ITER_P2 6
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 799 && ITERATE_LAST >= 700
+#undef _ITER_D2
+#define _ITER_D2 7
+#undef _ITER_P2
+#define _ITER_P2 7
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 899 && ITERATE_LAST >= 800
+#undef _ITER_D2
+#define _ITER_D2 8
+#undef _ITER_P2
+#define _ITER_P2 8
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#if ITERATE_FIRST <= 999 && ITERATE_LAST >= 900
+#undef _ITER_D2
+#define _ITER_D2 9
+#undef _ITER_P2
+#define _ITER_P2 9
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 2
+#endif
+#elif _ITER_DEPTH == 1
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 9 && ITERATE_LAST >= _ITER_D2 * 100 + 0
+#undef _ITER_D1
+#define _ITER_D1 0
+#undef _ITER_P1
+#if _ITER_D2
+#define _ITER_P1 0
+#else
+#define _ITER_P1
+#endif
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 19 && ITERATE_LAST >= _ITER_D2 * 100 + 10
+#undef _ITER_D1
+#define _ITER_D1 1
+#undef _ITER_P1
+#define _ITER_P1 1
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 29 && ITERATE_LAST >= _ITER_D2 * 100 + 20
+#undef _ITER_D1
+#define _ITER_D1 2
+#undef _ITER_P1
+#define _ITER_P1 2
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 39 && ITERATE_LAST >= _ITER_D2 * 100 + 30
+#undef _ITER_D1
+#define _ITER_D1 3
+#undef _ITER_P1
+#define _ITER_P1 3
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 49 && ITERATE_LAST >= _ITER_D2 * 100 + 40
+#undef _ITER_D1
+#define _ITER_D1 4
+#undef _ITER_P1
+#define _ITER_P1 4
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 59 && ITERATE_LAST >= _ITER_D2 * 100 + 50
+#undef _ITER_D1
+#define _ITER_D1 5
+#undef _ITER_P1
+#define _ITER_P1 5
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 69 && ITERATE_LAST >= _ITER_D2 * 100 + 60
+#undef _ITER_D1
+#define _ITER_D1 6
+#undef _ITER_P1
+#define _ITER_P1 6
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 79 && ITERATE_LAST >= _ITER_D2 * 100 + 70
+#undef _ITER_D1
+#define _ITER_D1 7
+#undef _ITER_P1
+#define _ITER_P1 7
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 89 && ITERATE_LAST >= _ITER_D2 * 100 + 80
+#undef _ITER_D1
+#define _ITER_D1 8
+#undef _ITER_P1
+#define _ITER_P1 8
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + 99 && ITERATE_LAST >= _ITER_D2 * 100 + 90
+#undef _ITER_D1
+#define _ITER_D1 9
+#undef _ITER_P1
+#define _ITER_P1 9
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 0
+#include "macro_iterate.h"
+#undef _ITER_DEPTH
+#define _ITER_DEPTH 1
+#endif
+#else
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 0 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 0
+#undef _ITER_D0
+#define _ITER_D0 0
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 1 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 1
+#undef _ITER_D0
+#define _ITER_D0 1
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 2 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 2
+#undef _ITER_D0
+#define _ITER_D0 2
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 3 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 3
+#undef _ITER_D0
+#define _ITER_D0 3
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 4 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 4
+#undef _ITER_D0
+#define _ITER_D0 4
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 5 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 5
+#undef _ITER_D0
+#define _ITER_D0 5
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 6 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 6
+#undef _ITER_D0
+#define _ITER_D0 6
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 7 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 7
+#undef _ITER_D0
+#define _ITER_D0 7
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 8 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 8
+#undef _ITER_D0
+#define _ITER_D0 8
+#include ITERATE_FILE
+#endif
+#if ITERATE_FIRST <= _ITER_D2 * 100 + _ITER_D1 * 10 + 9 && ITERATE_LAST >= _ITER_D2 * 100 + _ITER_D1 * 10 + 9
+#undef _ITER_D0
+#define _ITER_D0 9
+#include ITERATE_FILE
+#endif
+#endif
@@ -0,0 +1,70 @@
+/** Static parallel loops with Preprocessor */
+//splits fixed workloads into constant chunks for a known number of threads, no runtime scheduling
+
+#ifndef MACRO_PARALLEL_H
+#define MACRO_PARALLEL_H
+#include <pthread.h>
+#include "macro_codegen.h"
+#ifndef CODEGEN_CACHELINE
+#define CODEGEN_CACHELINE 64
+#endif
+
+/** Generates the THREADS + 1 chunk bounds for N items as constant expressions, thread t works on
+ * the items from the bound t up to the bound t + 1:
+ *   static const size_t bounds[] = {STATIC_PARTITION(1000,4)};	//0, 256, 512, 768, 1000
+ * The inner bounds are rounded to the nearest multiple of CODEGEN_CACHELINE items, so the chunks of an
+ * array aligned to a cache line never share one. STATIC_PARTITION_T rounds to the items of type T in
+ * a cache line instead. THREADS is a decimal literal below LOOPMAX, N may be any size_t expression.
+ * The chunks differ by at most a cache line. With less than a cache line per thread the bounds aren't
+ * rounded, so every thread still gets N / THREADS items:
+ *   STATIC_PARTITION(100,4)	//0, 25, 50, 75, 100 */
+#define STATIC_PARTITION(N,THREADS) _STATICPART(N,THREADS,CODEGEN_CACHELINE)
+#define STATIC_PARTITION_T(N,THREADS,T)\
+	_STATICPART(N,THREADS,(sizeof(T) < CODEGEN_CACHELINE ? CODEGEN_CACHELINE / sizeof(T) : 1))
+#define _STATICPART(N,THREADS,ALIGN) _PARTDROP(_MAPN(ARGNUM(RANGE(0,THREADS)),F_PARTBOUND,_MAPI0,(N,THREADS,ALIGN),RANGE(0,THREADS)))
+#define _PARTDROP(...) _DROP0(__VA_ARGS__)
+#define F_PARTBOUND(A,ARGS) , _PARTBOUND(A,_GENI ARGS)
+#define _PARTBOUND(...) _PARTBOUND0(__VA_ARGS__)
+#define _PARTBOUND0(T,N,THREADS,ALIGN) ((T) >= (THREADS) ? (size_t)(N) :\
+	(size_t)(N) / (THREADS) < (ALIGN) ? (size_t)(N) * (T) / (THREADS) : _PARTROUND((size_t)(N) * (T) / (THREADS),ALIGN))
+//the exact bounds are at least ALIGN apart, so the rounded ones are ordered and below N
+#define _PARTROUND(X,ALIGN) (((X) + (ALIGN) / 2) / (ALIGN) * (ALIGN))
+
+/** Defines int NAME(void *arg) which runs the loop over I from BEGIN to END on THREADS threads with the
+ * chunks of STATIC_PARTITION_T for the element type T. The calling thread works on the first chunk and
+ * joins the others:
+ *   PARALLEL_FOR(scale,4,float,i,0,N,((float *)arg)[i] *= 2;)
+ *   scale(data);
+ * The body and the bounds can access arg, BEGIN and END are evaluated once per call. If a thread can't be
+ * created, the remaining chunks run on the calling thread and the error of pthread_create is returned.
+ * Link with -pthread. */
+#define PARALLEL_FOR(NAME,THREADS,T,I,BEGIN,END,...)\
+	struct CONC(NAME,_chunk) { void *arg; size_t begin, end; };\
+	static void *CONC(NAME,_worker)(void *chunk) {\
+		void *arg = ((struct CONC(NAME,_chunk) *)chunk)->arg;\
+		(void)arg;\
+		for (size_t I = ((struct CONC(NAME,_chunk) *)chunk)->begin; I < ((struct CONC(NAME,_chunk) *)chunk)->end; I++) {\
+			__VA_ARGS__\
+		}\
+		return NULL;\
+	}\
+	static inline int NAME(void *arg) {\
+		const size_t begin = (BEGIN), n = (END) - begin, bounds[] = {STATIC_PARTITION_T(n,THREADS,T)};\
+		struct CONC(NAME,_chunk) chunks[THREADS];\
+		pthread_t threads[THREADS];\
+		int err = 0, t;\
+		(void)arg;\
+		for (t = 0; t < THREADS; t++)\
+			chunks[t] = (struct CONC(NAME,_chunk)){arg, begin + bounds[t], begin + bounds[t + 1]};\
+		for (t = 1; t < THREADS; t++)\
+			if ((err = pthread_create(&threads[t], NULL, CONC(NAME,_worker), &chunks[t])))\
+				break;\
+		for (int r = t; r < THREADS; r++)\
+			CONC(NAME,_worker)(&chunks[r]);\
+		CONC(NAME,_worker)(&chunks[0]);\
+		while (--t > 0)\
+			pthread_join(threads[t], NULL);\
+		return err;\
+	}
+
+#endif
@@ -0,0 +1,63 @@
+/** Scaling benchmark of PARALLEL_FOR from 1 to 8 threads */
+//gcc -O2 -pthread macro_parallel_bench.c -lm && ./a.out [items]
+//every item costs a few hundred cycles of arithmetic, so the loop scales until the threads exceed the cores
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "macro_parallel.h"
+
+static float *data;
+static size_t items = 1 << 22;
+
+//the number of threads has to be a literal, so there is one function per thread count
+#define WORK(NAME,THREADS) PARALLEL_FOR(NAME,THREADS,float,i,0,items,\
+	float x = ((float *)arg)[i];\
+	for (int k = 0; k < 16; k++)\
+		x = sqrtf(x * x + 1.0f) - 0.5f;\
+	((float *)arg)[i] = x;)
+WORK(work1,1)
+WORK(work2,2)
+WORK(work4,4)
+WORK(work8,8)
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+	static const struct { int threads; int (*run)(void *); } runs[] = {{1,work1},{2,work2},{4,work4},{8,work8}};
+	double single = 0, first = 0;
+	if (argc > 1)
+		items = strtoull(argv[1], NULL, 10);
+	if (!(data = malloc(items * sizeof *data)))
+		return 2;
+	printf("%zu items, %ld cores online\n", items, sysconf(_SC_NPROCESSORS_ONLN));
+	for (size_t r = 0; r < sizeof runs / sizeof *runs; r++) {
+		for (size_t i = 0; i < items; i++)
+			data[i] = (float)i;
+		double start = seconds();
+		int err = runs[r].run(data);
+		double elapsed = seconds() - start;
+		if (err)
+			fprintf(stderr, "pthread_create failed, the chunks ran on the calling thread\n");
+		//every thread count has to process each item exactly once
+		double sum = 0;
+		for (size_t i = 0; i < items; i++)
+			sum += data[i];
+		if (!r) {
+			single = elapsed;
+			first = sum;
+		} else if (sum != first) {
+			fprintf(stderr, "%d threads: checksum %f instead of %f\n", runs[r].threads, sum, first);
+			return 1;
+		}
+		printf("%d threads: %.1f ms, speedup %.2f\n", runs[r].threads, elapsed * 1e3, single / elapsed);
+	}
+	free(data);
+	return 0;
+}
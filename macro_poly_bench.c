@@ -0,0 +1,68 @@
+/** Throughput and latency benchmark of POLY_HORNER against POLY_ESTRIN for the degrees 4 to 16 */
+//gcc -O2 macro_poly_bench.c && ./a.out [passes]
+//gcc -O2 -mfma -DPOLY_FMA=__builtin_fma macro_poly_bench.c && ./a.out [passes]
+//the Taylor series of e^x, throughput evaluates independent x of an array, latency feeds every result into the
+//next x, where the dependency chain of Horner has the full length
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+#define N 1024
+//the coefficients 1/k! up to the degree
+#define C4 1,1,1/2.,1/6.,1/24.
+#define C8 1,1,1/2.,1/6.,1/24.,1/120.,1/720.,1/5040.,1/40320.
+#define C12 1,1,1/2.,1/6.,1/24.,1/120.,1/720.,1/5040.,1/40320.,1/362880.,1/3628800.,1/39916800.,1/479001600.
+#define C16 1,1,1/2.,1/6.,1/24.,1/120.,1/720.,1/5040.,1/40320.,1/362880.,1/3628800.,1/39916800.,1/479001600.,1/6227020800.,1/87178291200.,1/1307674368000.,1/20922789888000.
+//the extra level expands the coefficient list before POLY_* counts it
+#define HORNER(X,...) POLY_HORNER(X,__VA_ARGS__)
+#define ESTRIN(X,...) POLY_ESTRIN(X,__VA_ARGS__)
+#define KERNELS(D)\
+	static double horner##D(double x) { return HORNER(x,C##D); }\
+	static double estrin##D(double x) { return ESTRIN(x,C##D); }\
+	static void horner##D##_all(double *y, const double *x) { for (int i = 0; i < N; i++) y[i] = horner##D(x[i]); }\
+	static void estrin##D##_all(double *y, const double *x) { for (int i = 0; i < N; i++) y[i] = estrin##D(x[i]); }\
+	static double horner##D##_chain(double x) { for (int i = 0; i < N; i++) x = horner##D(x) * 0x1p-3; return x; }\
+	static double estrin##D##_chain(double x) { for (int i = 0; i < N; i++) x = estrin##D(x) * 0x1p-3; return x; }
+KERNELS(4)
+KERNELS(8)
+KERNELS(12)
+KERNELS(16)
+
+static double x[N], y[N], sink;
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+//nanoseconds per evaluation
+#define TIME(PASSES,...) ({\
+	double start = seconds();\
+	for (long k = 0; k < (PASSES); k++) {\
+		__VA_ARGS__;\
+		__asm__ volatile("" ::: "memory");\
+	}\
+	(seconds() - start) / (PASSES) / N * 1e9;\
+	})
+#define ROW(D,PASSES) printf("degree %2d: throughput Horner %.2f ns, Estrin %.2f ns, latency Horner %.2f ns, Estrin %.2f ns\n", D,\
+	TIME(PASSES, horner##D##_all(y, x)), TIME(PASSES, estrin##D##_all(y, x)),\
+	TIME(PASSES, sink += horner##D##_chain(0.5)), TIME(PASSES, sink += estrin##D##_chain(0.5)))
+
+int main(int argc, char **argv) {
+	long passes = argc > 1 ? strtol(argv[1], NULL, 10) : 20000;
+	for (int i = 0; i < N; i++)
+		x[i] = (i - N / 2) / (double)N;
+	//both schemes compute the same polynomial, up to rounding
+	for (int i = 0; i < N; i++)
+		if (__builtin_fabs(horner16(x[i]) - estrin16(x[i])) > 1e-12) {
+			fprintf(stderr, "Horner and Estrin differ at %f\n", x[i]);
+			return 1;
+		}
+	ROW(4,passes);
+	ROW(8,passes);
+	ROW(12,passes);
+	ROW(16,passes);
+	return sink != sink;
+}
@@ -0,0 +1,58 @@
+/** Benchmark of POOL against glibc malloc for small object churn */
+//gcc -O2 macro_pool_bench.c && ./a.out [operations]
+//a working set of 256 messages is kept alive, every operation frees a random one and allocates its replacement
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+#define LIVE 256
+struct msg { unsigned id; char payload[44]; };
+POOL(msgpool,struct msg,LIVE);
+static struct msg *live[LIVE];
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+static unsigned next_slot(unsigned *x) {
+	*x ^= *x << 13;
+	*x ^= *x >> 17;
+	*x ^= *x << 5;
+	return *x % LIVE;
+}
+
+//the same random order of slots for every allocator, returns nanoseconds per free and alloc
+#define CHURN(ALLOC,FREE,OPS,SUM) ({\
+	unsigned x = 1;\
+	for (unsigned i = 0; i < LIVE; i++)\
+		(live[i] = ALLOC)->id = i;\
+	double start = seconds();\
+	for (long k = 0; k < (OPS); k++) {\
+		unsigned s = next_slot(&x);\
+		SUM += live[s]->id;\
+		FREE(live[s]);\
+		(live[s] = ALLOC)->id = (unsigned)k;\
+	}\
+	double elapsed = seconds() - start;\
+	for (unsigned i = 0; i < LIVE; i++)\
+		FREE(live[i]);\
+	elapsed / (OPS) * 1e9;\
+	})
+
+int main(int argc, char **argv) {
+	long ops = argc > 1 ? strtol(argv[1], NULL, 10) : 20000000;
+	unsigned long sum[3] = {0};
+	double pool = CHURN(msgpool_alloc(),msgpool_free,ops,sum[0]);
+	double heap = CHURN(malloc(sizeof(struct msg)),free,ops,sum[1]);
+#if CODEGEN_ATOMICS
+	double locked = CHURN(msgpool_alloc_atomic(),msgpool_free_atomic,ops,sum[2]);
+	printf("POOL %.2f ns, POOL with spin lock %.2f ns, malloc %.2f ns per free and alloc\n", pool, locked, heap);
+#else
+	sum[2] = sum[0];
+	printf("POOL %.2f ns, malloc %.2f ns per free and alloc\n", pool, heap);
+#endif
+	return sum[0] != sum[1] || sum[0] != sum[2];
+}
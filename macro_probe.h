@@ -0,0 +1,66 @@
+/** Timing probes with Preprocessor */
+//measures code sections in place without an external profiler, they expand to nothing without MACRO_PROBES
+
+#ifndef MACRO_PROBE_H
+#define MACRO_PROBE_H
+#include "macro_codegen.h"
+
+/** Every probe site owns a static record with the number of runs and the total, minimum and maximum time
+ * in ticks of the time stamp counter (x86) or nanoseconds (clock_gettime). The records are registered in
+ * the linker table probes, so probe_dump lists all probes of the program without any initialization.
+ *   PROBE_BEGIN(parse);
+ *   ...
+ *   PROBE_END(parse);		//in the same block as PROBE_BEGIN
+ *   { PROBE_SCOPE(filter); ... }	//measures until the end of the block
+ *   probe_dump(stderr);
+ * The records are updated without synchronization, runs on concurrent threads may get lost.
+ * Define MACRO_PROBES before the inclusion to enable the probes. */
+#ifdef MACRO_PROBES
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROBE_UNIT "ticks"
+static inline uint64_t probe_now(void) { return __rdtsc(); }
+#else
+#include <time.h>
+#define PROBE_UNIT "ns"
+static inline uint64_t probe_now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+#endif
+struct probe { const char *name, *file; int line; uint64_t count, total, min, max; };
+TABLE_DECLARE(probes,struct probe *);
+TABLE_FINALIZE(probes)
+static inline void probe_record(struct probe *p, uint64_t t) {
+	if (!p->count++ || t < p->min)
+		p->min = t;
+	if (t > p->max)
+		p->max = t;
+	p->total += t;
+}
+static inline void probe_dump(FILE *f) {
+	for (const probes_t *p = probes_begin(); p != probes_end(); p++)
+		if ((*p)->count)
+			fprintf(f, "%s (%s:%d): %llu runs, %llu " PROBE_UNIT " total, avg %llu, min %llu, max %llu\n",
+				(*p)->name, (*p)->file, (*p)->line, (unsigned long long)(*p)->count,
+				(unsigned long long)(*p)->total, (unsigned long long)((*p)->total / (*p)->count),
+				(unsigned long long)(*p)->min, (unsigned long long)(*p)->max);
+}
+//declares the static record ID and registers it
+#define _PROBEDEF(ID,PNAME) static struct probe ID = {#PNAME, __FILE__, __LINE__, 0, 0, 0, 0}; REGISTER(probes,&ID)
+#define PROBE_BEGIN(PNAME) _PROBEDEF(_probe_ ## PNAME,PNAME); uint64_t _probe_start_ ## PNAME = probe_now()
+#define PROBE_END(PNAME) probe_record(&_probe_ ## PNAME, probe_now() - _probe_start_ ## PNAME)
+#define PROBE_SCOPE(PNAME) _PROBEDEF(NAME(PNAME),PNAME);\
+	__attribute__((cleanup(_probe_scope_end))) struct _probe_scope NAME(PNAME ## _scope) = {&NAME(PNAME), probe_now()}
+struct _probe_scope { struct probe *p; uint64_t start; };
+static inline void _probe_scope_end(struct _probe_scope *s) { probe_record(s->p, probe_now() - s->start); }
+#else
+#define PROBE_BEGIN(PNAME) MACRO()
+#define PROBE_END(PNAME) MACRO()
+#define PROBE_SCOPE(PNAME) MACRO()
+#define probe_dump(F) ((void)(F))
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+/** Benchmark of the chain of REDUCE against the balanced tree of TREE_REDUCE */
+//gcc -O2 macro_reduce_bench.c && ./a.out [passes]
+//every element of the output is the sum (or bitwise or) of 30 neighbouring inputs, the floating point sum
+//can't be reassociated by the compiler, so the chain has 29 dependent additions and the tree 5 levels
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_api.h"
+
+#define N 4096
+#define TERMS(P) P[0],P[1],P[2],P[3],P[4],P[5],P[6],P[7],P[8],P[9],P[10],P[11],P[12],P[13],P[14],P[15],P[16],P[17],P[18],P[19],P[20],P[21],P[22],P[23],P[24],P[25],P[26],P[27],P[28],P[29]
+#define CHAIN_ADD(A,AKK) (A + AKK)
+#define CHAIN_OR(A,AKK) (A | AKK)
+static double in[N + 30], out[N];
+static uint64_t bits[N + 30], ored[N];
+
+static void sum_chain(void) { for (int i = 0; i < N; i++) { const double *p = in + i; out[i] = REDUCE(CHAIN_ADD,0,TERMS(p)); } }
+static void sum_tree(void) { for (int i = 0; i < N; i++) { const double *p = in + i; out[i] = TREE_REDUCE_OP(+,TERMS(p)); } }
+static void or_chain(void) { for (int i = 0; i < N; i++) { const uint64_t *p = bits + i; ored[i] = REDUCE(CHAIN_OR,0,TERMS(p)); } }
+static void or_tree(void) { for (int i = 0; i < N; i++) { const uint64_t *p = bits + i; ored[i] = TREE_REDUCE_OP(|,TERMS(p)); } }
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+//nanoseconds per output element
+static double bench(void (*f)(void), long passes, double *check, const void *result, size_t size) {
+	double start = seconds();
+	for (long k = 0; k < passes; k++) {
+		f();
+		__asm__ volatile("" ::: "memory");	//keeps the passes from being merged
+	}
+	double elapsed = seconds() - start;
+	for (size_t i = 0; i < size; i++)
+		*check += ((const unsigned char *)result)[i];
+	return elapsed / passes / N * 1e9;
+}
+
+int main(int argc, char **argv) {
+	long passes = argc > 1 ? strtol(argv[1], NULL, 10) : 2000;
+	double check[4] = {0};
+	srand(1);
+	for (int i = 0; i < N + 30; i++) {
+		in[i] = rand() / (double)RAND_MAX;
+		bits[i] = 1ull << rand() % 64;
+	}
+	printf("30-term sum: REDUCE %.2f ns, TREE_REDUCE %.2f ns\n",
+		bench(sum_chain, passes, &check[0], out, sizeof out), bench(sum_tree, passes, &check[1], out, sizeof out));
+	printf("30-term or:  REDUCE %.2f ns, TREE_REDUCE %.2f ns\n",
+		bench(or_chain, passes, &check[2], ored, sizeof ored), bench(or_tree, passes, &check[3], ored, sizeof ored));
+	return check[2] != check[3];
+}
@@ -0,0 +1,79 @@
+/** Stress test of SPSC_QUEUE with a producer and a consumer thread */
+//gcc -O2 -pthread macro_spsc_test.c && ./a.out [elements]
+//the producer pushes an increasing sequence in batches of changing size, the consumer checks that every
+//element arrives once and in order, so a missing acquire or release shows up as a gap or a stale element
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "macro_codegen.h"
+
+SPSC_QUEUE(seqq,size_t,1024);
+static struct seqq q;
+static size_t total = 10000000;
+
+static void *produce(void *arg) {
+	size_t batch[64];
+	(void)arg;
+	for (size_t next = 0, n = 1; next < total; n = n % 64 + 1) {
+		size_t k = 0;
+		while (k < n && next + k < total) {
+			batch[k] = next + k;
+			k++;
+		}
+		//single pushes too, they are the other path through push_n
+		if (n == 1) {
+			while (!seqq_push(&q, batch[0]))
+				sched_yield();
+			next++;
+			continue;
+		}
+		for (size_t done = 0; done < k; ) {
+			size_t m = seqq_push_n(&q, batch + done, k - done);
+			if (!m)
+				sched_yield();
+			done += m;
+		}
+		next += k;
+	}
+	return NULL;
+}
+
+static double seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+	pthread_t producer;
+	size_t batch[64], expected = 0, n = 1;
+	if (argc > 1)
+		total = strtoull(argv[1], NULL, 10);
+	double start = seconds();
+	if (pthread_create(&producer, NULL, produce, NULL)) {
+		perror("pthread_create");
+		return 2;
+	}
+	while (expected < total) {
+		size_t m = n == 1 ? (size_t)seqq_pop(&q, batch) : seqq_pop_n(&q, batch, n);
+		if (!m)
+			sched_yield();
+		for (size_t i = 0; i < m; i++, expected++)
+			if (batch[i] != expected) {
+				fprintf(stderr, "element %zu is %zu\n", expected, batch[i]);
+				return 1;
+			}
+		n = n % 37 + 1;
+	}
+	pthread_join(producer, NULL);
+	double elapsed = seconds() - start;
+	if (seqq_pop(&q, batch)) {
+		fprintf(stderr, "element %zu after the end\n", batch[0]);
+		return 1;
+	}
+	printf("%zu elements in order, %.3f s, %.1f M/s\n", total, elapsed, total / elapsed * 1e-6);
+	return 0;
+}